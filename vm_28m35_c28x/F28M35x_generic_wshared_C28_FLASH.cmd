@@ -86,8 +86,8 @@ PAGE 1 :   /* Data Memory */
    RAMS6       : origin = 0x012000, length = 0x001000     /* on-chip Shared RAM block S6 */
    RAMS7       : origin = 0x013000, length = 0x001000     /* on-chip Shared RAM block S7 */
 
-   CTOMRAM     : origin = 0x03F800, length = 0x000380     /* C28 to M3 Message RAM */
-   MTOCRAM     : origin = 0x03FC00, length = 0x000380     /* M3 to C28 Message RAM */
+   CTOMRAM     : origin = 0x03F800, length = 0x000200     /* C28 to M3 Message RAM, 0x200 onward holds the IPC ring (Ipc_ring.h) */
+   MTOCRAM     : origin = 0x03FC00, length = 0x000200     /* M3 to C28 Message RAM, 0x200 onward holds the IPC ring (Ipc_ring.h) */
    
    FLASHB      : origin = 0x13C000, length = 0x002000     /* on-chip FLASH */
 }
@@ -137,6 +137,32 @@ SECTIONS
    #endif
 #endif
    
+   /* Control-loop fast path: the ADC ISR, Adcread/Adcdeal, all of
+      Vector_control.c and Trig_table.c and their constants are loaded
+      in FLASHE and copied to RAML1 by main() before interrupts are
+      enabled.  RAML1 is the budget: if the code outgrows it the link
+      fails here.  The run size is listed under "fastcode" in the map
+      file (${ProjName}.map) together with the fastdata usage of RAML3. */
+   fastcode            : LOAD = FLASHE,
+                         RUN = RAML1,
+                         LOAD_START(_FastcodeLoadStart),
+                         LOAD_SIZE(_FastcodeLoadSize),
+                         LOAD_END(_FastcodeLoadEnd),
+                         RUN_START(_FastcodeRunStart),
+                         RUN_SIZE(_FastcodeRunSize),
+                         RUN_END(_FastcodeRunEnd),
+                         PAGE = 0, ALIGN(4)
+   {
+       *(fastcode)
+       *Vector_control.obj(.text)
+       *Vector_control.obj(.econst)
+       *Trig_table.obj(.text)
+       *Trig_table.obj(.econst)
+   }
+
+   /* State touched every control period, kept together in one block */
+   fastdata            : > RAML3,      PAGE = 1
+
    /* The following section definitions are required when using the IPC API Drivers */ 
    GROUP : > CTOMRAM, PAGE = 1 
    {
@@ -77,8 +77,8 @@ PAGE 1 :
    RAMS6       : origin = 0x012000, length = 0x001000     /* on-chip Shared RAM block S6 */
    RAMS7       : origin = 0x013000, length = 0x001000     /* on-chip Shared RAM block S7 */
 
-   CTOMRAM     : origin = 0x03F800, length = 0x000380     /* C28 to M3 Message RAM */
-   MTOCRAM     : origin = 0x03FC00, length = 0x000380     /* M3 to C28 Message RAM */
+   CTOMRAM     : origin = 0x03F800, length = 0x000200     /* C28 to M3 Message RAM, 0x200 onward holds the IPC ring (Ipc_ring.h) */
+   MTOCRAM     : origin = 0x03FC00, length = 0x000200     /* M3 to C28 Message RAM, 0x200 onward holds the IPC ring (Ipc_ring.h) */
 }
 
 
@@ -97,6 +97,14 @@ SECTIONS
    #endif
 #endif    
    
+   fastcode         : >  RAML1,                      PAGE = 0
+   {
+       *(fastcode)
+       *Vector_control.obj(.text)
+       *Vector_control.obj(.econst)
+       *Trig_table.obj(.text)
+       *Trig_table.obj(.econst)
+   }
    .text            : >> RAMM0 | RAML0 | RAML1,      PAGE = 0
    .cinit           : >  RAMM0 | RAML0 | RAML1,      PAGE = 0
    .pinit           : >> RAMM0 | RAML0 | RAML1,      PAGE = 0
@@ -104,6 +112,7 @@ SECTIONS
    .reset           : >  RESET,                      PAGE = 0, TYPE = DSECT /* not used, */
 
    .stack           : >  RAMM1 | RAML2 | RAML3,      PAGE = 1
+   fastdata         : >  RAML3,                      PAGE = 1
    .ebss            : >> RAML2 | RAML3 | RAMM1,      PAGE = 1
    .econst          : >> RAMM1 | RAML2 | RAML3,      PAGE = 1
    .esysmem         : >> RAMM1 | RAML2 | RAML3,      PAGE = 1
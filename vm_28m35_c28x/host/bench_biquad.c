@@ -0,0 +1,120 @@
+/*
+ * bench_biquad.c
+ *   DDSRF12·20HzͨBIQUAD_BANK_CALCFILTRATE_BANK_CALC(ÿ·һFILTRATE_CALC)
+ *   ͬһ룬һ¡doubleο൱ٱÿĵĺʱ
+ *   ʱֵֻĿҪڰISR_PROFILE
+ *   DDSRF_BIQUAD_BANKֱȡ10PROF_DROOP(Vector_control.h)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define BQ_NUM   (CTRL_ISR_FS*2)//2s
+#define BQ_TIME  200//ʱظ
+//dqֱ+100HzƵ+ֵͨͬ
+#define BQ_DC    300.0f
+#define BQ_AC    30.0f
+
+static float Bq_x[BQ_NUM][BIQUAD_BANK_NUM];
+static float Bq_y[2][BQ_NUM][BIQUAD_BANK_NUM];
+
+static double BqNow(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return t.tv_sec+t.tv_nsec*1e-9;
+}
+
+static void BqInput(void)
+{
+    Uint32 k;
+    Uint16 i;
+
+    srand(1);
+    for(k=0;k<BQ_NUM;k++)
+        for(i=0;i<BIQUAD_BANK_NUM;i++)
+            Bq_x[k][i]=(BQ_DC+BQ_AC*sin(2*CTRL_PI*100*k*CTRL_ISR_T+i))*(i+1)/BIQUAD_BANK_NUM
+                       +(1.0f*rand()/RAND_MAX-0.5f);
+}
+
+//sel 0BIQUAD_BANK_CALC1FILTRATE_BANK_CALCrec=1ʱ
+static void BqPass(Uint16 sel,Uint16 rec)
+{
+    BIQUAD_BANK b=BIQUAD_BANK_DEFAULTS_20Hz;
+    FILTRATE f[BIQUAD_BANK_NUM]=FILTRATE_BANK_DEFAULTS_20Hz;
+    Uint32 k;
+    Uint16 i;
+
+    for(k=0;k<BQ_NUM;k++)
+    {
+        for(i=0;i<BIQUAD_BANK_NUM;i++)
+            b.X_in[i]=Bq_x[k][i];
+        if(sel==0)
+            BIQUAD_BANK_CALC(&b);
+        else
+            FILTRATE_BANK_CALC(&b,f);
+        if(rec)
+            for(i=0;i<BIQUAD_BANK_NUM;i++)
+                Bq_y[sel][k][i]=b.Y[i];
+    }
+}
+
+//ÿ(12·)ʱns
+static double BqTime(Uint16 sel)
+{
+    double t0=BqNow();
+    Uint16 r;
+
+    for(r=0;r<BQ_TIME;r++)
+        BqPass(sel,0);
+    return (BqNow()-t0)*1e9/BQ_TIME/BQ_NUM;
+}
+
+int main(void)
+{
+    double x1[BIQUAD_BANK_NUM]={0},x2[BIQUAD_BANK_NUM]={0};
+    double y1[BIQUAD_BANK_NUM]={0},y2[BIQUAD_BANK_NUM]={0};
+    double y,e[2]={0,0},d=0,t[2];
+    Uint32 k;
+    Uint16 i,s;
+
+    BqInput();
+    BqPass(0,1);
+    BqPass(1,1);
+    //doubleοֱIͣϵͬһ
+    for(k=0;k<BQ_NUM;k++)
+        for(i=0;i<BIQUAD_BANK_NUM;i++)
+        {
+            y=LPF20Hz_A1*Bq_x[k][i]+LPF20Hz_A2*x1[i]+LPF20Hz_A3*x2[i]-LPF20Hz_B1*y1[i]-LPF20Hz_B2*y2[i];
+            x2[i]=x1[i];x1[i]=Bq_x[k][i];
+            y2[i]=y1[i];y1[i]=y;
+            for(s=0;s<2;s++)
+                if(fabs(Bq_y[s][k][i]-y)>e[s]) e[s]=fabs(Bq_y[s][k][i]-y);
+            if(fabs(Bq_y[0][k][i]-Bq_y[1][k][i])>d) d=fabs(Bq_y[0][k][i]-Bq_y[1][k][i]);
+        }
+    printf("[biquad] %d channels, %d ticks, input up to %.0f, max |error| vs double\n",
+           BIQUAD_BANK_NUM,BQ_NUM,BQ_DC+BQ_AC);
+    printf("  BIQUAD_BANK_CALC   %.3e\n",e[0]);
+    printf("  FILTRATE_BANK_CALC %.3e\n",e[1]);
+    //20Hzļ1ܽfloat뱻Ŵ1/(1+b1+b2)ֽṹ0.2LSB£벻ͬͬһ
+    SimCheck("bank vs double / ADC_U LSB",e[0]/ADC_U,0,0.5);
+    SimCheck("filtrate vs double / ADC_U LSB",e[1]/ADC_U,0,0.5);
+    SimCheck("bank / filtrate error ratio",e[0]/e[1],0.2,5);
+    SimCheck("bank - filtrate / ADC_U LSB",d/ADC_U,0,0.5);
+
+    //߶ͬ12·
+    printf("[biquad] host time per tick, 12 channels incl. input copy (relative only)\n");
+    t[0]=BqTime(0);
+    t[1]=BqTime(1);
+    printf("  BIQUAD_BANK_CALC   %6.1f ns\n",t[0]);
+    printf("  FILTRATE_BANK_CALC %6.1f ns  (x%.2f)\n",t[1],t[1]/t[0]);
+    printf("  target: ISR_PROFILE build, DDSRF_BIQUAD_BANK 1 and 0, Paramet[%d]/[%d] (PROF_DROOP mean/max us)\n",
+           PROF_PARAMET_BASE+2*PROF_DROOP,PROF_PARAMET_BASE+2*PROF_DROOP+1);
+
+    printf("[biquad] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
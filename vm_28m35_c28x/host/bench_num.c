@@ -0,0 +1,237 @@
+/*
+ * bench_num.c
+ *   float32IQ24(Num_type.h)ͬһ룺
+ *   任abc_dq0pn  +˲(DDSRF) һPI鵥һһ׶ջ
+ *   ļݣbuild/bench_num(float)build/bench_num_iq(-DNUM_USE_IQ=1Makefile)
+ *   floatʱIQǷݣӹܵıȽ
+ *   (12λADCLSB)ÿĵĳ˷ͽ˴ʱ
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+#include "Iq_math.h"
+
+#define NB_NUM    (CTRL_ISR_FS*2)//2s20Hz˲̬
+#define NB_PN     5//DspQspDsnQsnV0
+#define NB_DDSRF  4//UdpUqpUdnUqn˲
+#define NB_PI     PI_BANK_NUM
+#define NB_SIG    (NB_PN+NB_DDSRF+NB_PI)
+#define NB_STAGE  3
+#define NB_TIME   20//ʱظ
+
+//룺311V15V56VӡLSBľ
+#define NB_UP     311.0f
+#define NB_UN     15.0f
+#define NB_U5     6.0f
+//PI飺3Hz 2V+50Hz 1Vi(1+i)ȡParamet_Initĵѹ޷20A
+//ǵѹһ׹(NB_PL_Rŷ50Hz)float㣬һ
+//ʱֻ_IQmpyضϵ-0.5LSBÿۼӳб£ջʵʵЧ
+#define NB_KP_P   0.001f
+#define NB_KI_P   0.015f
+#define NB_KP_N   0.5f
+#define NB_KI_N   0.005f
+#define NB_PI_MAX 20.0f
+#define NB_PL_R   10.0f
+#define NB_PL_A   (2*CTRL_PI*50*CTRL_ISR_T)
+
+static float Nb_u[NB_NUM][3];
+static float Nb_th[NB_NUM];
+static float Nb_r[NB_NUM];
+static float Nb_out[NB_NUM][NB_SIG];
+static Uint32 Nb_mpy[NB_STAGE],Nb_cvt[NB_STAGE];
+#if !NUM_USE_IQ//Ƚֻfloat
+static float Nb_ref[NB_NUM][NB_SIG];
+static float Nb_e[NB_STAGE];///LSB
+static const char *Nb_stage[NB_STAGE]={"abc_dq0pn","DDSRF (jieou+biquad)","PI_BANK_CALC"};
+static const Uint16 Nb_first[NB_STAGE+1]={0,NB_PN,NB_PN+NB_DDSRF,NB_SIG};
+
+//׵ֱͨ(a1+a2+a3)/(1+b1+b2)iq=1ʱϵȰ_IQض
+static double NbDcGain(Uint16 iq)
+{
+    double a[5]={LPF20Hz_A1,LPF20Hz_A2,LPF20Hz_A3,LPF20Hz_B1,LPF20Hz_B2};
+    Uint16 i;
+
+    if(iq)
+        for(i=0;i<5;i++)
+            a[i]=_IQ(a[i])*(1.0/(1L<<GLOBAL_Q));
+    return (a[0]+a[1]+a[2])/(1+a[3]+a[4]);
+}
+#endif
+
+static double NbNow(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return t.tv_sec+t.tv_nsec*1e-9;
+}
+
+static void NbInput(void)
+{
+    float th,ph;
+    Uint32 k;
+    Uint16 x;
+
+    srand(1);
+    for(k=0;k<NB_NUM;k++)
+    {
+        th=(w0*CTRL_ISR_T)*k;
+        th-=(2*CTRL_PI)*(Uint32)(th*(1/(2*CTRL_PI)));
+        Nb_th[k]=th;
+        for(x=0;x<3;x++)
+        {
+            ph=x*(2*CTRL_PI/3);
+            Nb_u[k][x]=NB_UP*cos(th-ph)+NB_UN*cos(-th-ph+0.3f)+NB_U5*cos(5*th+ph)
+                      +ADC_U*(1.0f*rand()/RAND_MAX-0.5f);
+        }
+        Nb_r[k]=2*sin(2*CTRL_PI*3*k*CTRL_ISR_T)+sin(th);
+    }
+}
+
+//һ飺Vector_control.cdroop()һˣcount=1ʱǼ
+static void NbPass(Uint16 count)
+{
+    ABC_DQPN pn=ABC_DQPN_DEFAULTS;
+    DDSRF_PLL d=DDSRF_PLL_DEFAULTS(U_DDSRF_CH);
+    BIQUAD_BANK f=BIQUAD_BANK_DEFAULTS_20Hz;
+    PI_BANK pi=PI_BANK_DEFAULTS;
+    float y[NB_PI]={0};
+    Uint32 k,m0,c0;
+    Uint16 i;
+
+    PI_BANK_COMMIT(&pi,PI_DP,2,NB_KP_P,NB_KI_P,NB_PI_MAX,-NB_PI_MAX);
+    PI_BANK_COMMIT(&pi,PI_DN,2,NB_KP_N,NB_KI_N,NB_PI_MAX,-NB_PI_MAX);
+    Num_mpy_cnt=0;
+    Num_cvt_cnt=0;
+    for(k=0;k<NB_NUM;k++)
+    {
+        Theta_context.Angle=Nb_th[k];
+        ANGLE_CONTEXT_CALC(&Theta_context);
+
+        m0=Num_mpy_cnt;c0=Num_cvt_cnt;
+        pn.As=NUM_IN(Nb_u[k][0]);
+        pn.Bs=NUM_IN(Nb_u[k][1]);
+        pn.Cs=NUM_IN(Nb_u[k][2]);
+        abc_dq0pn(&pn,&Theta_context);
+        Nb_out[k][0]=NUM_OUT(pn.Dsp);
+        Nb_out[k][1]=NUM_OUT(pn.Qsp);
+        Nb_out[k][2]=NUM_OUT(pn.Dsn);
+        Nb_out[k][3]=NUM_OUT(pn.Qsn);
+        Nb_out[k][4]=NUM_OUT(pn.V0);
+        if(count){Nb_mpy[0]+=Num_mpy_cnt-m0;Nb_cvt[0]+=Num_cvt_cnt-c0;}
+
+        m0=Num_mpy_cnt;c0=Num_cvt_cnt;
+        d.Udp=NUM_IN(Nb_out[k][0]);
+        d.Uqp=NUM_IN(Nb_out[k][1]);
+        d.Udn=NUM_IN(Nb_out[k][2]);
+        d.Uqn=NUM_IN(Nb_out[k][3]);
+        DDSRF_PLL_IN(&d,&f);
+        BIQUAD_BANK_CALC(&f);
+        DDSRF_PLL_OUT(&d,&f);
+        Nb_out[k][5]=NUM_OUT(d.Udpout);
+        Nb_out[k][6]=NUM_OUT(d.Uqpout);
+        Nb_out[k][7]=NUM_OUT(d.Udnout);
+        Nb_out[k][8]=NUM_OUT(d.Uqnout);
+        if(count){Nb_mpy[1]+=Num_mpy_cnt-m0;Nb_cvt[1]+=Num_cvt_cnt-c0;}
+
+        m0=Num_mpy_cnt;c0=Num_cvt_cnt;
+        for(i=0;i<NB_PI;i++)
+        {
+            pi.Pi[i].qInRef=NUM_IN(Nb_r[k]*(1+i));
+            pi.Pi[i].qInMeas=NUM_IN(y[i]);
+        }
+        PI_BANK_CALC(&pi);
+        for(i=0;i<NB_PI;i++)
+            Nb_out[k][NB_PN+NB_DDSRF+i]=NUM_OUT(pi.Pi[i].qOut);
+        if(count){Nb_mpy[2]+=Num_mpy_cnt-m0;Nb_cvt[2]+=Num_cvt_cnt-c0;}
+        for(i=0;i<NB_PI;i++)
+            y[i]+=NB_PL_A*(NB_PL_R*Nb_out[k][NB_PN+NB_DDSRF+i]-y[i]);
+    }
+}
+
+//ÿʱ(ns)ֵֻ
+static double NbTime(void)
+{
+    double t0=NbNow();
+    Uint16 r;
+
+    for(r=0;r<NB_TIME;r++)
+        NbPass(0);
+    return (NbNow()-t0)*1e9/NB_TIME/NB_NUM;
+}
+
+#if NUM_USE_IQ
+//IQֻѽдstdout
+int main(void)
+{
+    double ns;
+
+    InitTrigTable();
+    NbInput();
+    NbPass(1);
+    ns=NbTime();
+    fwrite(&ns,sizeof(ns),1,stdout);
+    fwrite(Nb_out,sizeof(Nb_out),1,stdout);
+    return 0;
+}
+#else
+int main(int argc,char **argv)
+{
+    char cmd[256];
+    FILE *fp;
+    double ns,ns_iq;
+    float e,emax,lsb;
+    Uint32 k;
+    Uint16 s,j;
+
+    InitTrigTable();
+    NbInput();
+    NbPass(1);
+    ns=NbTime();
+    memcpy(Nb_ref,Nb_out,sizeof(Nb_out));
+    snprintf(cmd,sizeof(cmd),"%s_iq",argv[0]);
+    fp=popen(cmd,"r");
+    if(fp==NULL||fread(&ns_iq,sizeof(ns_iq),1,fp)!=1||fread(Nb_out,sizeof(Nb_out),1,fp)!=1)
+    {
+        printf("[num] cannot read %s\n",cmd);
+        return 1;
+    }
+    pclose(fp);
+
+    printf("[num] float32 vs IQ24 (NUM_IQ_SCALE=%d), %d ticks, same input\n",NUM_IQ_SCALE,NB_NUM);
+    printf("  stage                  max|IQ24-float|    in LSB   per tick: NUM_MPY  NUM_IN/OUT\n");
+    for(s=0;s<NB_STAGE;s++)
+    {
+        emax=0;
+        for(k=0;k<NB_NUM;k++)
+            for(j=Nb_first[s];j<Nb_first[s+1];j++)
+            {
+                e=fabs(Nb_out[k][j]-Nb_ref[k][j]);
+                if(e>emax) emax=e;
+            }
+        lsb=(s==2)?ADC_I:ADC_U;//PIǵ
+        printf("  %-22s %12.3e %s  %8.4f  %16.1f  %10.1f\n",Nb_stage[s],emax,(s==2)?"A":"V",
+               emax/lsb,(float)Nb_mpy[s]/NB_NUM,(float)Nb_cvt[s]/NB_NUM);
+        Nb_e[s]=emax/lsb;
+    }
+    printf("  NUM_K at run time (float->IQ in the IQ24 build, counted from the source):\n");
+    printf("    abc_dq0pn 2 (cos, sin), DDSRF 4 (2 per JIEOU_CALC)\n");
+    //DDSRFҪ20HzϵضϺֱ棺1+b1+b2ֻ6e-4bĽضϱŴ
+    printf("  20Hz biquad DC gain: float %.6f, IQ24 %.6f (%.3f V at %.0f V)\n",NbDcGain(0),NbDcGain(1),
+           (NbDcGain(0)-NbDcGain(1))*NB_UP,NB_UP);
+    SimCheck("abc_dq0pn error / LSB",Nb_e[0],0,0.01);
+    SimCheck("DDSRF error / LSB",Nb_e[1],0,1);
+    SimCheck("PI_BANK error / LSB (closed loop)",Nb_e[2],0,0.1);
+
+    printf("[num] host time per tick, all three stages (relative only; x86 has FPU and 64-bit multiply)\n");
+    printf("  float32 %7.1f ns\n",ns);
+    printf("  IQ24    %7.1f ns\n",ns_iq);
+
+    printf("[num] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * bench_trig.c
+ *   Ҳ(Trig_table.c)libmÿεõϵĺʱ
+ *   Լȡ(ͬͬһ㷨RAMռ)
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define TRIG_SWEEP_MAX  (4*CTRL_PI)//ƻĽǶȣȡ[0,2)١120㣬
+#define TRIG_SWEEP_NUM  4000000
+#define TRIG_TIME_NUM   10000000
+#define TRIG_LSB        (1.0/4096)//12λADCһLSB
+#define TRIG_BITS_MIN   5
+#define TRIG_BITS_MAX   11
+
+static float Trig_ref_table[(1<<TRIG_BITS_MAX)+1];
+
+//Trig_sinͬ㷨2^bitsȽϲͬ
+static float TrigRef(float angle,Uint16 bits)
+{
+    float x,frac;
+    int32 k;
+    Uint16 idx;
+
+    x=angle*((1<<bits)/6.283185307);
+    k=(int32)x;
+    if(x<k)
+        k--;
+    frac=x-k;
+    idx=k&((1<<bits)-1);
+    return Trig_ref_table[idx]+frac*(Trig_ref_table[idx+1]-Trig_ref_table[idx]);
+}
+
+static double TrigNow(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return t.tv_sec+t.tv_nsec*1e-9;
+}
+
+static float TrigAngle(Uint32 i,Uint32 num)
+{
+    return -TRIG_SWEEP_MAX+2*TRIG_SWEEP_MAX*i/(double)(num-1);
+}
+
+int main(void)
+{
+    double es=0,ec=0,esc=0,e,t0,t1;
+    float a,s,c;
+    volatile float sink=0;
+    Uint32 i,diff=0;
+    Uint16 b,n;
+
+    InitTrigTable();
+
+    printf("[trig] max |error| vs libm, %d points over [-4pi,4pi]\n",TRIG_SWEEP_NUM);
+    for(i=0;i<TRIG_SWEEP_NUM;i++)
+    {
+        a=TrigAngle(i,TRIG_SWEEP_NUM);
+        e=fabs(Trig_sin(a)-sin((double)a));
+        if(e>es) es=e;
+        e=fabs(Trig_cos(a)-cos((double)a));
+        if(e>ec) ec=e;
+        Trig_sincos(a,&s,&c);
+        e=fabs(s-sin((double)a));
+        if(e>esc) esc=e;
+        e=fabs(c-cos((double)a));
+        if(e>esc) esc=e;
+    }
+    //h^2/8h=2/256ټfloat
+    SimCheck("Trig_sin",es,0,7.6e-5);
+    SimCheck("Trig_cos",ec,0,7.6e-5);
+    SimCheck("Trig_sincos",esc,0,7.6e-5);
+
+    //h^2/8ÿһλ1/4RAM(2^bits+1)floatһ
+    printf("[trig] table size vs error (same algorithm), 12-bit LSB = %.2e\n",TRIG_LSB);
+    printf("  bits  points  RAM(words)  max|err|    err/LSB\n");
+    for(b=TRIG_BITS_MIN;b<=TRIG_BITS_MAX;b++)
+    {
+        n=1<<b;
+        for(i=0;i<=n;i++)
+            Trig_ref_table[i]=sin(i*(6.283185307/n));
+        es=0;
+        for(i=0;i<TRIG_SWEEP_NUM/4;i++)
+        {
+            a=TrigAngle(i,TRIG_SWEEP_NUM/4);
+            e=fabs(TrigRef(a,b)-sin((double)a));
+            if(e>es) es=e;
+            if(b==TRIG_TABLE_BITS&&TrigRef(a,b)!=Trig_sin(a))
+                diff++;
+        }
+        printf("  %4u  %6u  %10u  %.3e   %.2f%s\n",b,n,2*(n+1),es,es/TRIG_LSB,
+               b==TRIG_TABLE_BITS?"   <- TRIG_TABLE_BITS":"");
+        if(b==TRIG_TABLE_BITS-1)
+            SimCheck("one bit smaller exceeds 1 LSB",es/TRIG_LSB,1,100);
+        if(b==TRIG_TABLE_BITS)
+        {
+            SimCheck("TrigRef!=Trig_sin points",diff,0,0);
+            SimCheck("TRIG_TABLE_BITS within 1 LSB",es/TRIG_LSB,0,1);
+        }
+    }
+
+    //C28 FPUÿεõ㣬Trig_table.cԴ
+    //  궨1ˣȡF32TOI32ǶжI32TOF32+Ƚ(Ƕk--תһ)
+    //  frac 1±1(cosټ1/4)ֵȡ2ֵ111
+    printf("[trig] per-call operations (counted from Trig_table.c)\n");
+    printf("  call         fmul  fadd/sub  f<->i  cmp  and/add  table loads\n");
+    printf("  Trig_sin        2         3    2-3    1        1            2\n");
+    printf("  Trig_cos        2         3    2-3    1        2            2\n");
+    printf("  Trig_sincos     3         5    2-3    1        3            4\n");
+    printf("  (Trig_sin+Trig_cos: 4 fmul, 6 fadd/sub, 4-6 conversions, 2 cmp)\n");
+
+    //ʱֵֻĿҪڰPROF_PARK
+    printf("[trig] host time per call, %d calls (relative only)\n",TRIG_TIME_NUM);
+    t0=TrigNow();
+    for(i=0;i<TRIG_TIME_NUM;i++)
+        sink+=Trig_sin(TrigAngle(i,TRIG_TIME_NUM));
+    t1=TrigNow();
+    printf("  Trig_sin     %6.2f ns\n",(t1-t0)*1e9/TRIG_TIME_NUM);
+    t0=TrigNow();
+    for(i=0;i<TRIG_TIME_NUM;i++)
+    {
+        Trig_sincos(TrigAngle(i,TRIG_TIME_NUM),&s,&c);
+        sink+=s+c;
+    }
+    t1=TrigNow();
+    printf("  Trig_sincos  %6.2f ns\n",(t1-t0)*1e9/TRIG_TIME_NUM);
+    t0=TrigNow();
+    for(i=0;i<TRIG_TIME_NUM;i++)
+        sink+=sinf(TrigAngle(i,TRIG_TIME_NUM));
+    t1=TrigNow();
+    printf("  libm sinf    %6.2f ns\n",(t1-t0)*1e9/TRIG_TIME_NUM);
+    t0=TrigNow();
+    for(i=0;i<TRIG_TIME_NUM;i++)
+    {
+        a=TrigAngle(i,TRIG_TIME_NUM);
+        sink+=sinf(a)+cosf(a);
+    }
+    t1=TrigNow();
+    printf("  libm sinf+cosf %4.2f ns\n",(t1-t0)*1e9/TRIG_TIME_NUM);
+    t0=TrigNow();
+    for(i=0;i<TRIG_TIME_NUM;i++)
+        sink+=TrigAngle(i,TRIG_TIME_NUM);
+    t1=TrigNow();
+    printf("  loop overhead %5.2f ns\n",(t1-t0)*1e9/TRIG_TIME_NUM);
+
+    printf("[trig] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
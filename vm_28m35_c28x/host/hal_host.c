@@ -0,0 +1,24 @@
+/*
+ * hal_host.c
+ *   Ӳʲ㣺bsp.hHOST_BUILD֧ı
+ *   ԼĿCPUĴļṩķ
+ */
+
+#include "DSP28x_Project.h"
+
+volatile Uint16 Hal_adc_result[HAL_ADC_NUM];//дADC
+volatile Uint16 Hal_cmpa[3];//ждCMPAһزװ
+volatile Uint16 Hal_isr_ack;//жϳڼ
+
+volatile unsigned int IER;//C28CPUĴ
+volatile unsigned int IFR;
+
+//F28M35x_usDelay.asm
+void DSP28x_usDelay(Uint32 Count)
+{
+    (void)Count;
+}
+
+//Num_type.hNUM_COUNT
+Uint32 Num_mpy_cnt;
+Uint32 Num_cvt_cnt;
@@ -0,0 +1,45 @@
+/*
+ * host_c28.h
+ *
+ *  ʱ-includeǿưͷļ֮ǰ
+ *  ȥC28Ĺؼֺ࣬ͰC28λ¶壬
+ *  F28M35x_Device.hͬtypedefԴĺ걣
+ *  ĴṹTIͷļĴF28M35x_GlobalVariableDefs.cͨڴ
+ */
+
+#ifndef HOST_C28_H_
+#define HOST_C28_H_
+
+#include <stdint.h>
+
+#define interrupt
+#define __interrupt
+#define cregister
+#define __cregister
+#define asm(x)
+#define __asm(x)
+
+//C28int 16λlong 32λdoublefloatͬΪ32λ
+#define DSP28_DATA_TYPES
+typedef int16_t int16;
+typedef int32_t int32;
+typedef int64_t int64;
+typedef uint64_t Uint64;
+typedef float float32;
+typedef double float64;
+
+#define _TI_STD_TYPES
+typedef int16_t Int;
+typedef uint16_t Uns;
+typedef char Char;
+typedef char *String;
+typedef void *Ptr;
+typedef uint16_t Bool;
+typedef uint32_t Uint32;
+typedef uint16_t Uint16;
+typedef unsigned char Uint8;
+typedef int32_t Int32;
+typedef int16_t Int16;
+typedef char Int8;
+
+#endif /* HOST_C28_H_ */
@@ -0,0 +1,105 @@
+/*
+ * plant.c
+ *   ·˵plant.h
+ */
+
+#include "DSP28x_Project.h"
+#include "plant.h"
+
+//ADC֡·λãAdc_self.c˳һ£֡ĿһADC_FRAME_NUM
+static const Uint16 Plant_slot[ADC_FRAME_NUM]={ADC_SLOT_IA,ADC_SLOT_IB,ADC_SLOT_IC,
+                                               ADC_SLOT_UA,ADC_SLOT_UB,ADC_SLOT_UC,
+                                               ADC_SLOT_IOA,ADC_SLOT_IOB,ADC_SLOT_IOC,
+                                               ADC_SLOT_UOA};
+
+//ƣȥ
+static void PlantNoZero(float *x)
+{
+	float z=(x[0]+x[1]+x[2])*(1.0f/3);
+
+	x[0]-=z;
+	x[1]-=z;
+	x[2]-=z;
+}
+
+//ƽģͣһزϹܵͨ(PRD-CMPA)/PRD
+//ڼܶأűʱ¹ܶÿزTdĸߵƽʱTd
+void PLANT_CALC(PLANT_handle p)
+{
+	float dt=CTRL_ISR_T/p->Sub;
+	float kd=p->Td*CTRL_FS;//ռһزڵı
+	float d,ug;
+	Uint16 k,x;
+
+	for(k=0;k<p->Sub;k++)
+	{
+		for(x=0;x<3;x++)
+		{
+			d=(float)(CTRL_PWM_PRD-p->Cmp[x])/CTRL_PWM_PRD;
+			if(p->Il[x]>0) d-=kd;
+			if(p->Il[x]<0) d+=kd;
+			if(d<0) d=0;
+			if(d>1) d=1;
+			p->Ui[x]=p->Udc*(d-0.5f);
+		}
+		PlantNoZero(p->Ui);
+		//ʽŷþɵѹݵѹµLCг񲻻ֵɢ
+		for(x=0;x<3;x++)
+		{
+			if(p->Pwm)
+				p->Il[x]+=dt/p->Lf*(p->Ui[x]-p->Rf*p->Il[x]-p->Uc[x]);
+			else
+				p->Il[x]=0;//űۿ·˲еܿ
+			if(p->Eg>0)
+			{
+				ug=p->Eg*cos(p->Thg-x*(2*CTRL_PI/3));
+				p->Io[x]+=dt/p->Lg*(p->Uc[x]-p->Rg*p->Io[x]-ug);
+				p->Uo[x]=ug;
+			}
+			else
+			{
+				p->Io[x]+=dt/p->Lg*(p->Uc[x]-(p->Rg+p->Rl[x])*p->Io[x]);
+				p->Uo[x]=p->Rl[x]*p->Io[x];
+			}
+		}
+		PlantNoZero(p->Il);
+		PlantNoZero(p->Io);
+		for(x=0;x<3;x++)
+			p->Uc[x]+=dt/p->Cf*(p->Il[x]-p->Io[x]);
+		p->Thg+=p->Wg*dt;
+		if(p->Thg>2*CTRL_PI)
+			p->Thg-=2*CTRL_PI;
+	}
+	p->Tick++;
+}
+
+//CTR=0жһдCMPAӰӼĴװ
+void PLANT_LOAD(PLANT_handle p,volatile Uint16 *cmpa)
+{
+	p->Cmp[0]=cmpa[0];
+	p->Cmp[1]=cmpa[1];
+	p->Cmp[2]=cmpa[2];
+}
+
+//CTR=0ADC_IADC_Uֵƫ12λ
+//UobUocûADC(ADC_FRAME_NUM)д
+void PLANT_SAMPLE(PLANT_handle p,volatile Uint16 *res)
+{
+	float v[12];
+	float c;
+	Uint16 i;
+
+	for(i=0;i<3;i++)
+	{
+		v[i]=p->Il[i]/ADC_I;
+		v[3+i]=p->Uc[i]/ADC_U;
+		v[6+i]=p->Io[i]/ADC_I;
+		v[9+i]=p->Uo[i]/ADC_U;
+	}
+	for(i=0;i<ADC_FRAME_NUM;i++)
+	{
+		c=PLANT_ADC_ZERO+p->Ofs[i]+v[i];
+		c=(c<0)?0:(c>PLANT_ADC_MAX)?PLANT_ADC_MAX:c+0.5f;
+		res[Plant_slot[i]]=(Uint16)c;
+	}
+}
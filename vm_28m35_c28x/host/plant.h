@@ -0,0 +1,57 @@
+/*
+ * plant.h
+ *
+ *  ·(ƽģͣ)  LC˲  ·  PCC
+ *  PCC踺(µ)Eg>0ʱ
+ *  ƣű۵ѹ͸֧·ÿȥ൱ڸǵλԶ
+ *  CMPAждһز(CTR=0)װأĿӰӼĴһ
+ */
+
+#ifndef PLANT_H_
+#define PLANT_H_
+
+#define PLANT_ADC_ZERO 2048//ADC(һ)
+#define PLANT_ADC_MAX  4095
+
+typedef struct {  float  Udc;//ֱĸߵѹ(V)
+				  float  Lf;//ű۲(H)
+				  float  Rf;
+				  float  Cf;//˲(F)ǽ
+				  float  Lg;//·(H)
+				  float  Rg;
+				  float  Rl[3];//ص()Բͬ
+				  float  Eg;//ѹֵ(V)0Ϊµ
+				  float  Wg;//Ƶ(rad/s)
+				  float  Td;//(s)
+				  Uint16 Sub;//ÿزڵĻֲ
+				  int16  Ofs[12];//·ADCƫ(LSB)УҪȥ
+				  float  Il[3];//״̬ű۵Ϊ
+				  float  Uc[3];//ݵѹ
+				  float  Io[3];//·PCCΪ
+				  float  Uo[3];//PCCѹ
+				  float  Ui[3];//űƽѹ(Ըе)
+				  float  Thg;//λ
+				  Uint16 Cmp[3];//ЧCMPA
+				  Uint16 Pwm;//10űۿ·
+				  Uint32 Tick;//ѷز
+		 	 	} PLANT;
+
+typedef PLANT*PLANT_handle;
+//1000Vĸ(M=500Ӧ)3mH/20uF·1mHÿ40Լ3.6kWPWM_DEADBANDͬ
+#define PLANT_DEFAULTS {1000,\
+	                    3e-3,0.05,20e-6,\
+	                    1e-3,0.05,\
+	                    {40,40,40},\
+	                    0,2*CTRL_PI*50,\
+	                    PWM_DEADBAND/(float)CTRL_TBCLK,\
+	                    50,\
+	                    {0},\
+	                    {0},{0},{0},{0},{0},0,\
+	                    {CTRL_PWM_PRD/2,CTRL_PWM_PRD/2,CTRL_PWM_PRD/2},\
+	                    0,0}
+
+void PLANT_CALC(PLANT_handle);//һز
+void PLANT_LOAD(PLANT_handle,volatile Uint16*);//CTR=0װCMPA
+void PLANT_SAMPLE(PLANT_handle,volatile Uint16*);//CTR=0дADCĴ
+
+#endif /* PLANT_H_ */
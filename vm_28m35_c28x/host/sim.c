@@ -0,0 +1,69 @@
+/*
+ * sim.c
+ *   ջ棬˵sim.h
+ */
+
+#include <stdio.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+float Sim_t=0;
+Uint16 Sim_fail=0;
+
+//main()ĳʼ˳һ£û壬
+void SimInit(PLANT_handle p)
+{
+    InitTrigTable();
+    Initparameter();
+    ProfileInit();
+    Hal_cmpa[0]=CTRL_PWM_PRD/2;
+    Hal_cmpa[1]=CTRL_PWM_PRD/2;
+    Hal_cmpa[2]=CTRL_PWM_PRD/2;
+    Hal_isr_ack=0;
+    Sim_t=0;
+    p->Tick=0;
+}
+
+//һжڡѭĿÿжܺܶȦÿһȦ
+void SimTick(PLANT_handle p)
+{
+    PLANT_LOAD(p,Hal_cmpa);
+    p->Pwm=FlagRegs.flagsystem.bit.pwmon;
+    PLANT_SAMPLE(p,Hal_adc_result);
+    adca1_interrupt_isr();
+    CtrlBackground();
+    PLANT_CALC(p);
+    Sim_t=p->Tick*CTRL_ISR_T;
+}
+
+void SimRun(PLANT_handle p,float t)
+{
+    Uint32 k=CTRL_ISR_TICKS(t);
+
+    while(k--)
+        SimTick(p);
+}
+
+//ƵDFTx[0..num-1]ÿλǰwtȡhгķֵ
+//numȡڣй©Ժ
+float SimHarm(const float *x,Uint32 num,float wt,Uint16 h)
+{
+    double re=0,im=0;
+    Uint32 i;
+
+    for(i=0;i<num;i++)
+    {
+        re+=x[i]*cos(h*wt*i);
+        im+=x[i]*sin(h*wt*i);
+    }
+    return 2*sqrt(re*re+im*im)/num;
+}
+
+void SimCheck(const char *name,float v,float lo,float hi)
+{
+    int ok=(v>=lo&&v<=hi);
+
+    printf("  %-32s %12.6g  [%g, %g]  %s\n",name,v,lo,hi,ok?"ok":"FAIL");
+    if(!ok)
+        Sim_fail++;
+}
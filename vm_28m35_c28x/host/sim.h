@@ -0,0 +1,24 @@
+/*
+ * sim.h
+ *
+ *  ջ棺ÿж
+ *  CTR=0װCMPA  adca1_interrupt_isr()  CtrlBackground()  ·һ
+ *  ƴĿԭļHOST_BUILD룬Makefile
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include "plant.h"
+
+//SimInitֱ֮ӸParametλ·һCtrlBackgroundȡ
+void SimInit(PLANT_handle);
+void SimTick(PLANT_handle);
+void SimRun(PLANT_handle,float);//t
+float SimHarm(const float*,Uint32,float,Uint16);//hгֵ
+void SimCheck(const char*,float,float,float);//ӡһ[lo,hi]һʧ
+
+extern float Sim_t;//ʱ(s)
+extern Uint16 Sim_fail;//ʧԳ
+
+#endif /* SIM_H_ */
@@ -0,0 +1,87 @@
+/*
+ * test_dtc.c
+ *   (Modulator.c DeadTimeComp)ͬһջͬһأ/̬ܵ
+ *   Ƚűƽѹݵѹű۵57г
+ */
+
+#include <stdio.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define DTC_CYC  10//ͳõĻ
+#define DTC_NUM  (CTRL_ISR_FS/50*DTC_CYC)
+#define DTC_SIG  3//ű۵ѹݵѹű۵
+
+static PLANT Plant=PLANT_DEFAULTS;
+static float Dtc_x[DTC_SIG][3][DTC_NUM];
+static const char *Dtc_name[DTC_SIG]={"bridge Ui (V)","capacitor Uc (V)","bridge Il (A)"};
+
+//¼DTC_CYCڣh[sig][0..1]Ϊ57гƽֵh1Ϊ
+static void DtcRecord(float h[DTC_SIG][2],float h1[DTC_SIG])
+{
+    float wt;
+    Uint32 i;
+    Uint16 s,x;
+
+    for(i=0;i<DTC_NUM;i++)
+    {
+        SimTick(&Plant);
+        for(x=0;x<3;x++)
+        {
+            Dtc_x[0][x][i]=Plant.Ui[x];
+            Dtc_x[1][x][i]=Plant.Uc[x];
+            Dtc_x[2][x][i]=Plant.Il[x];
+        }
+    }
+    wt=w*CTRL_ISR_T;
+    for(s=0;s<DTC_SIG;s++)
+    {
+        h[s][0]=0;
+        h[s][1]=0;
+        h1[s]=0;
+        for(x=0;x<3;x++)
+        {
+            h1[s]+=SimHarm(Dtc_x[s][x],DTC_NUM,wt,1)/3;
+            h[s][0]+=SimHarm(Dtc_x[s][x],DTC_NUM,wt,5)/3;
+            h[s][1]+=SimHarm(Dtc_x[s][x],DTC_NUM,wt,7)/3;
+        }
+    }
+}
+
+//ͣʼƷʽ̬ܵ¼
+static void DtcRun(Uint16 sel,float h[DTC_SIG][2],float h1[DTC_SIG])
+{
+    Paramet[modulation]=sel;
+    Switchsystem=1;
+    SimRun(&Plant,1.0);
+    DtcRecord(h,h1);
+    Switchsystem=0;
+    SimRun(&Plant,0.2);
+}
+
+int main(void)
+{
+    float off[DTC_SIG][2],on[DTC_SIG][2],h1off[DTC_SIG],h1on[DTC_SIG];
+    Uint16 s;
+
+    SimInit(&Plant);
+    SimRun(&Plant,0.3);//У
+    printf("[dtc] closed loop, %g ohm load, dead time %d TBCLK (%.2f%% of carrier period)\n",
+           Plant.Rl[0],PWM_DEADBAND,100.0*PWM_DEADBAND/(2*CTRL_PWM_PRD));
+    DtcRun(0,off,h1off);//SPWM
+    DtcRun(4,on,h1on);//SPWM
+    printf("  signal              h1 off    h1 on    h5 off   h5 on   h7 off   h7 on\n");
+    for(s=0;s<DTC_SIG;s++)
+        printf("  %-18s %8.3f %8.3f  %7.3f %7.3f  %7.3f %7.3f\n",Dtc_name[s],
+               h1off[s],h1on[s],off[s][0],on[s][0],off[s][1],on[s][1]);
+    //5ټ룬7ٽ1/4ű۵ûƲMOD_DT_IBANDƲȡ
+    //㸽ƫ٣7ʣöЩ
+    SimCheck("Uc h5 on/off",on[1][0]/off[1][0],0,0.5);
+    SimCheck("Uc h7 on/off",on[1][1]/off[1][1],0,0.75);
+    SimCheck("Ui h5 on/off",on[0][0]/off[0][0],0,0.5);
+    SimCheck("Ui h7 on/off",on[0][1]/off[0][1],0,0.75);
+    SimCheck("Uc h1 unchanged (on/off)",h1on[1]/h1off[1],0.99,1.01);
+
+    printf("[dtc] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
@@ -0,0 +1,140 @@
+/*
+ * test_loop.c
+ *   ջ棺ϵУ  ԳƸ  زƽ⣬ѹֵƵʡ䡢ƽ
+ *    ȽǷͣٿ
+ */
+
+#include <stdio.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define LOOP_CYC   10//ͳõĻ
+#define LOOP_NUM   (CTRL_ISR_FS/50*LOOP_CYC)
+#define LOOP_HMAX  20//THD㵽20
+
+static PLANT Plant=PLANT_DEFAULTS;
+static float Loop_u[3][LOOP_NUM];
+static float Loop_ipk;//¼ڼű۵ֵ
+
+//¼LOOP_CYCڵĵݵѹԼwDFT
+static void LoopRecord(float *amp,float *thd,float *vuf)
+{
+    float wt,h1[3],hn,sum;
+    float re[3],im[3],pr,pi,nr,ni;
+    Uint32 i;
+    Uint16 x,h;
+
+    Loop_ipk=0;
+    for(i=0;i<LOOP_NUM;i++)
+    {
+        SimTick(&Plant);
+        for(x=0;x<3;x++)
+        {
+            Loop_u[x][i]=Plant.Uc[x];
+            if(fabs(Plant.Il[x])>Loop_ipk)
+                Loop_ipk=fabs(Plant.Il[x]);
+        }
+    }
+    wt=w*CTRL_ISR_T;
+    sum=0;
+    for(x=0;x<3;x++)
+    {
+        h1[x]=SimHarm(Loop_u[x],LOOP_NUM,wt,1);
+        for(h=2;h<=LOOP_HMAX;h++)
+        {
+            hn=SimHarm(Loop_u[x],LOOP_NUM,wt,h);
+            sum+=hn*hn;
+        }
+        //x=Re{Xe^{jwt}}鲿ȡ-sin
+        re[x]=0;
+        im[x]=0;
+        for(i=0;i<LOOP_NUM;i++)
+        {
+            re[x]+=Loop_u[x][i]*cos(wt*i);
+            im[x]-=Loop_u[x][i]*sin(wt*i);
+        }
+    }
+    *amp=(h1[0]+h1[1]+h1[2])/3;
+    *thd=sqrt(sum/3)/(*amp);
+    //ԳƷa+b+^2ca+^2b+c=e^{j2/3}
+    pr=re[0]+cos(2*CTRL_PI/3)*(re[1]+re[2])-sin(2*CTRL_PI/3)*(im[1]-im[2]);
+    pi=im[0]+cos(2*CTRL_PI/3)*(im[1]+im[2])+sin(2*CTRL_PI/3)*(re[1]-re[2]);
+    nr=re[0]+cos(2*CTRL_PI/3)*(re[1]+re[2])+sin(2*CTRL_PI/3)*(im[1]-im[2]);
+    ni=im[0]+cos(2*CTRL_PI/3)*(im[1]+im[2])-sin(2*CTRL_PI/3)*(re[1]-re[2]);
+    *vuf=sqrt((nr*nr+ni*ni)/(pr*pr+pi*pi));
+}
+
+int main(void)
+{
+    Uint16 i;
+    float amp,thd,vuf;
+
+    for(i=0;i<12;i++)
+        Plant.Ofs[i]=(int16)(i*7%13)-6;//·ƫ-6~+6
+    SimInit(&Plant);
+
+    printf("[loop] power-up, PWM blocked, offset calibration\n");
+    SimRun(&Plant,0.3);
+    SimCheck("AC0CheckFinished",FlagRegs.flagsystem.bit.AC0CheckFinished,1,1);
+    for(i=0;i<ADC_FRAME_NUM;i++)
+    {
+        float e=(float)AC_ZeroMean[i]-(PLANT_ADC_ZERO+Plant.Ofs[i]);
+        if(e<-1||e>1)
+            SimCheck("AC_ZeroMean error (LSB)",e,-1,1);
+    }
+
+    printf("[loop] start, balanced %g ohm load\n",Plant.Rl[0]);
+    Switchsystem=1;
+    SimRun(&Plant,1.0);
+    LoopRecord(&amp,&thd,&vuf);
+    SimCheck("pwmon",FlagRegs.flagsystem.bit.pwmon,1,1);
+    SimCheck("Uc fundamental (V)",amp,U0*0.95,U0*1.05);
+    SimCheck("Uc THD",thd,0,0.05);
+    SimCheck("Uc VUF",vuf,0,0.01);
+    SimCheck("w (rad/s)",w,w0*0.99,w0*1.01);
+    SimCheck("P (W)",P,1000,10000);
+
+    printf("[loop] phase a load %g -> %g ohm\n",Plant.Rl[0],Plant.Rl[0]/2);
+    Plant.Rl[0]/=2;
+    SimRun(&Plant,1.0);
+    LoopRecord(&amp,&thd,&vuf);
+    SimCheck("Uc fundamental (V)",amp,U0*0.95,U0*1.05);
+    SimCheck("Uc VUF",vuf,0,0.02);
+    SimCheck("Il peak (A), within ADC range",Loop_ipk,0,2048*ADC_I);
+    SimCheck("Modulator.Overmod",Modulator.Overmod,0,0);
+    SimCheck("Hal_isr_ack",Hal_isr_ack,Plant.Tick,Plant.Tick);
+
+    //ȽTZжסȽҲԼ壬Ҫͣٿ
+    printf("[loop] comparator trip, latched until stop -> start\n");
+    Comp1Regs.COMPSTS.bit.COMPSTS=1;
+    EPwm1Regs.TZFLG.bit.OST=1;
+    EPwm1Regs.TZFLG.bit.DCAEVT1=1;
+    HardwareFaultLatch();
+    SimRun(&Plant,0.1);
+    Comp1Regs.COMPSTS.bit.COMPSTS=0;
+    SimRun(&Plant,0.1);
+    SimCheck("faultoccur, comparator released",FlagRegs.flagsystem.bit.faultoccur,1,1);
+    SimCheck("ocfault, comparator released",FlagRegs.flagfault.bit.ocfault,1,1);
+    SimCheck("Paramet[faultoccurr]",Paramet[faultoccurr],1,1);
+    SimCheck("pwmon",FlagRegs.flagsystem.bit.pwmon,0,0);
+    Comp1Regs.COMPSTS.bit.COMPSTS=1;
+    Switchsystem=1;//Ƚڶʱλ
+    SimRun(&Plant,0.1);
+    SimCheck("faultoccur, start while tripped",FlagRegs.flagsystem.bit.faultoccur,1,1);
+    SimCheck("pwmon",FlagRegs.flagsystem.bit.pwmon,0,0);
+    Comp1Regs.COMPSTS.bit.COMPSTS=0;
+    SimRun(&Plant,0.1);
+    SimCheck("faultoccur, no new start edge",FlagRegs.flagsystem.bit.faultoccur,1,1);
+    Switchsystem=0;
+    SimRun(&Plant,0.1);
+    SimCheck("faultoccur, stopped",FlagRegs.flagsystem.bit.faultoccur,1,1);
+    Switchsystem=1;
+    SimRun(&Plant,0.1);
+    SimCheck("faultoccur, stop -> start",FlagRegs.flagsystem.bit.faultoccur,0,0);
+    SimCheck("ocfault",FlagRegs.flagfault.bit.ocfault,0,0);
+    SimCheck("Paramet[faultoccurr]",Paramet[faultoccurr],0,0);
+    SimCheck("pwmon",FlagRegs.flagsystem.bit.pwmon,1,1);
+
+    printf("[loop] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
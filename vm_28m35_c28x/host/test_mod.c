@@ -0,0 +1,101 @@
+/*
+ * test_mod.c
+ *   MODULATOR_CALCɨ裺SPWM/MINMAX  ޷/ȱƱȴ0.1ɨ1.5
+ *   |m|MmaxCMPA[0,PRD]ߵѹ=3kƲ
+ *   ȱСʱߵѹλ䣻ߵѹk
+ */
+
+#include <stdio.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define MOD_T_NUM   360//ÿڵĵ
+#define MOD_T_KSTEP 0.01f
+#define MOD_T_KMAX  1.5f
+#define MOD_T_LIN   1e-4f//ߵѹֵ
+#define MOD_T_PHASE 1e-4f//ȱСʱߵѹλ(rad)
+
+static float Mod_uab[MOD_T_NUM];
+
+//һڣߵѹabֵλ*mmaxΪ|m|ֵ
+static void ModCycle(MODULATOR *p,float k,float *amp,float *ph,float *mmax,Uint16 *cmp_bad)
+{
+	float th,re=0,im=0,x;
+	Uint16 i;
+
+	*mmax=0;
+	for(i=0;i<MOD_T_NUM;i++)
+	{
+		th=2*CTRL_PI*i/MOD_T_NUM;
+		p->Ua=k*cos(th);
+		p->Ub=k*cos(th-2*CTRL_PI/3);
+		p->Uc=k*cos(th+2*CTRL_PI/3);
+		MODULATOR_CALC(p);
+		x=fabs(p->Ma);
+		if(fabs(p->Mb)>x) x=fabs(p->Mb);
+		if(fabs(p->Mc)>x) x=fabs(p->Mc);
+		if(x>*mmax) *mmax=x;
+		if(p->Cmpa>MOD_PWM_PRD||p->Cmpb>MOD_PWM_PRD||p->Cmpc>MOD_PWM_PRD)
+			(*cmp_bad)++;
+		Mod_uab[i]=p->Ma-p->Mb;
+		re+=Mod_uab[i]*cos(th);
+		im-=Mod_uab[i]*sin(th);
+	}
+	*amp=2*sqrt(re*re+im*im)/MOD_T_NUM;
+	*ph=atan2(im,re);
+}
+
+static void ModSweep(Uint16 sel,float mmax_set)
+{
+	MODULATOR p=MODULATOR_DEFAULTS;
+	float k,amp,ph,mm,klin,emax=0,phmax=0,mworst=0,amp_last=0,drop=0;
+	Uint16 cmp_bad=0,ovm_lin=0,ovm_out=1;
+
+	MODULATOR_MODE(&p,sel);
+	p.Kdc=1;//UaֱӸ
+	p.Mmax=mmax_set;
+	//SPWMѹֵMmaxMINMAXߵѹֵ2Mmaxѹ2/3Mmax
+	klin=(p.Mode==MOD_MINMAX)?mmax_set*2/sqrt(3.0):mmax_set;
+	printf("[mod] %s %s, Mmax=%.2f, linear up to k=%.4f\n",
+	       p.Mode==MOD_MINMAX?"MINMAX":"SPWM",p.Ovm==MOD_OVM_SCALE?"SCALE":"CLAMP",mmax_set,klin);
+	for(k=MOD_T_KSTEP;k<=MOD_T_KMAX+1e-6f;k+=MOD_T_KSTEP)
+	{
+		p.Overmod=0;
+		ModCycle(&p,k,&amp,&ph,&mm,&cmp_bad);
+		if(mm>mworst) mworst=mm;
+		if(amp<amp_last-1e-5f&&amp_last-amp>drop) drop=amp_last-amp;
+		amp_last=amp;
+		if(k<=klin*(1-1e-3f))
+		{
+			//ߵѹ=3kλ=30
+			if(fabs(amp/(sqrt(3.0)*k)-1)>emax) emax=fabs(amp/(sqrt(3.0)*k)-1);
+			if(p.Overmod) ovm_lin++;
+		}
+		else if(k>=klin*(1+1e-3f))
+		{
+			if(p.Overmod==0) ovm_out=0;
+			if(p.Ovm==MOD_OVM_SCALE&&fabs(ph-CTRL_PI/6)>phmax) phmax=fabs(ph-CTRL_PI/6);
+		}
+	}
+	SimCheck("max |m| over sweep",mworst,0,mmax_set+1e-6f);
+	SimCheck("CMPA outside [0,PRD]",cmp_bad,0,0);
+	SimCheck("linear: |Uab/(sqrt3 k)-1|",emax,0,MOD_T_LIN);
+	SimCheck("linear: Overmod count",ovm_lin,0,0);
+	SimCheck("beyond linear: Overmod seen",ovm_out,1,1);
+	SimCheck("Uab fundamental drop with k",drop,0,0);
+	if(p.Ovm==MOD_OVM_SCALE)
+		SimCheck("overmod: Uab phase error (rad)",phmax,0,MOD_T_PHASE);
+}
+
+int main(void)
+{
+	Uint16 sel;
+
+	for(sel=0;sel<4;sel++)
+	{
+		ModSweep(sel,1.0f);
+		ModSweep(sel,0.95f);//Сʱ
+	}
+	printf("[mod] %s\n",Sim_fail?"FAIL":"PASS");
+	return Sim_fail?1:0;
+}
@@ -0,0 +1,91 @@
+/*
+ * test_park.c
+ *   abc_dq0pnԭķֿ任ȼۣ
+ *   DspQspV0abc_dq0p(Angle=)DsnQsnabc_dq0n(Angle=-)
+ *   ԼͬһǶĵabc_dq0p_ctx/abc_dq0n_ctx
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "DSP28x_Project.h"
+#include "sim.h"
+
+#define PARK_NUM  20000//
+#define PARK_AMP  400.0f//abcȡֵΧPARK_AMP
+//PARK_AMP
+//ͬһģֻмγ˼ӵfloat룻
+//abc_dq0p/abc_dq0n߸ԲټϲԲֵ(2/256)^2/87.5e-5
+#define PARK_TOL_CTX 2e-6f
+#define PARK_TOL     2e-4f
+
+static float ParkRand(float a)
+{
+    return a*(2.0f*rand()/RAND_MAX-1);
+}
+
+static void ParkMax(float *e,float x,float y)
+{
+    float d=fabs(x-y);
+
+    if(d>*e)
+        *e=d;
+}
+
+int main(void)
+{
+    ABC_DQPN pn=ABC_DQPN_DEFAULTS;
+    ABC_PARK p=CLARKE_PARK_DEFAULTS;
+    ABC_PARK n=CLARKE_PARK_DEFAULTS;
+    ABC_PARK pc=CLARKE_PARK_DEFAULTS;
+    ABC_PARK nc=CLARKE_PARK_DEFAULTS;
+    ANGLE_CONTEXT a=ANGLE_CONTEXT_DEFAULTS;
+    float ep=0,en=0,e0=0,ec=0,ex=0;
+    Uint32 k;
+
+    InitTrigTable();
+    srand(1);
+    printf("[park] abc_dq0pn vs abc_dq0p(th)/abc_dq0n(-th), %d random points\n",PARK_NUM);
+    for(k=0;k<PARK_NUM;k++)
+    {
+        //ȡNCOķΧ[0,2)Ӽ߽
+        a.Angle=(k<4)?k*(CTRL_PI/2):(2*CTRL_PI)*rand()/((float)RAND_MAX+1);
+        ANGLE_CONTEXT_CALC(&a);
+        p.As=ParkRand(PARK_AMP);
+        p.Bs=ParkRand(PARK_AMP);
+        p.Cs=ParkRand(PARK_AMP);
+        n=p;
+        pc=p;
+        nc=p;
+        pn.As=NUM_IN(p.As);
+        pn.Bs=NUM_IN(p.Bs);
+        pn.Cs=NUM_IN(p.Cs);
+
+        p.Angle=a.Angle;
+        abc_dq0p(&p);
+        n.Angle=-a.Angle;
+        abc_dq0n(&n);
+        abc_dq0pn(&pn,&a);
+        abc_dq0p_ctx(&pc,&a);
+        abc_dq0n_ctx(&nc,&a);
+
+        ParkMax(&ep,NUM_OUT(pn.Dsp),p.Ds);
+        ParkMax(&ep,NUM_OUT(pn.Qsp),p.Qs);
+        ParkMax(&en,NUM_OUT(pn.Dsn),n.Ds);
+        ParkMax(&en,NUM_OUT(pn.Qsn),n.Qs);
+        ParkMax(&e0,NUM_OUT(pn.V0),p.V0);
+        ParkMax(&ex,NUM_OUT(pn.Dsp),pc.Ds);
+        ParkMax(&ex,NUM_OUT(pn.Qsp),pc.Qs);
+        ParkMax(&ex,NUM_OUT(pn.Dsn),nc.Ds);
+        ParkMax(&ex,NUM_OUT(pn.Qsn),nc.Qs);
+        ParkMax(&ec,nc.Ds,n.Ds);
+        ParkMax(&ec,nc.Qs,n.Qs);
+    }
+    SimCheck("pn vs p/n_ctx, same context",ex/PARK_AMP,0,PARK_TOL_CTX);
+    SimCheck("pn Dsp/Qsp vs abc_dq0p(th)",ep/PARK_AMP,0,PARK_TOL);
+    SimCheck("pn Dsn/Qsn vs abc_dq0n(-th)",en/PARK_AMP,0,PARK_TOL);
+    SimCheck("pn V0 vs abc_dq0p",e0/PARK_AMP,0,PARK_TOL_CTX);
+    SimCheck("abc_dq0n_ctx vs abc_dq0n(-th)",ec/PARK_AMP,0,PARK_TOL);
+
+    printf("[park] %s\n",Sim_fail?"FAIL":"PASS");
+    return Sim_fail?1:0;
+}
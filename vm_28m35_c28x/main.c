@@ -13,9 +13,8 @@
 #include "DSP28x_Project.h"     // DSP28x Headerfile
 //#include "F28M35x_Ipc_drivers.h"
 
-//#ifdef _FLASH
-//#pragma CODE_SECTION(adca1_interrupt_isr,"ramfuncs");//ָĳramramfuncs
-//#endif
+//жϷfastcodeΣFLASHϵ󿽵RAML1ȴ
+#pragma CODE_SECTION(adca1_interrupt_isr,"fastcode");
 
 
 //_iq a,b,c;
@@ -26,13 +25,6 @@
 void main(void)
 {
 
-// Define Local  Variables
-    Uint32 *pulMsgRam;
-    Uint16 counter;
-
-    Uint16 *pusCBufferPt = (void *)C28_S0SARAM_START;
-    Uint16 *pusMBufferPt = (void *)(C28_S0SARAM_START + usMBuffer_SIZE);
-
     InitSysCtrl();
 
 #ifdef _FLASH
@@ -41,6 +33,8 @@ void main(void)
 // The  RamfuncsLoadStart, RamfuncsLoadSize, and RamfuncsRunStart
 // symbols are created by the linker. Refer to the device .cmd file.
     memcpy(&RamfuncsRunStart, &RamfuncsLoadStart, (size_t)&RamfuncsLoadSize);
+// ƻٴ(жϡVector_control.c䳣)ͬRAM
+    memcpy(&FastcodeRunStart, &FastcodeLoadStart, (size_t)&FastcodeLoadSize);
 
 // Call Flash Initialization to setup flash waitstates
 // This function must reside in RAM
@@ -56,35 +50,41 @@ void main(void)
 
     InitBoardGpio();
     ConfigureEPwm();
+    ConfigureProtect();
     ConfigureADC();
+#if ADC_USE_DMA
+    ConfigureAdcDma();
+#endif
     //ConfigureXint();
+    InitTrigTable();
     Initparameter();
+    ProfileInit();//жϷֶμʱReleaseΪ
 
     EALLOW;
     //PieVectTable.SCIRXINTA = &scirxintab_isr;//SCIжӳַ
+#if ADC_USE_DMA
+    PieVectTable.DINTCH1=&adca1_interrupt_isr;//DMA֡ж
+#else
     PieVectTable.ADCINT1=&adca1_interrupt_isr;//׽жӳַ
+#endif
     PieVectTable.XINT1=&xint1_isr;//ⲿж2018/1/3
-    //PieVectTable.MTOCIPC_INT1 = &MtoCIPC1IntHandler;
-    PieVectTable.MTOCIPC_INT2 = &MtoCIPC2IntHandler;
+    PieVectTable.EPWM1_TZINT=&epwm1_tz_isr;//Ӳ
     EDIS;
 
-    // Step 4. Initialize the Device Peripherals:
-    //IPCCInitialize (&g_sIpcController1, IPC_INT1, IPC_INT1);
-    IPCCInitialize (&g_sIpcController2, IPC_INT2, IPC_INT2);
-
     //ʹCPUж
     //IER |=M_INT9;//SCIж     CPUж1~9(뿪ŶӦCPUжϿ)
     IER |=M_INT1;//cputime and adc andⲿж
-    IER |= M_INT11;
+    IER |= M_INT2;//EPWM1 TZ
+    PieCtrlRegs.PIEIER2.bit.INTx1 = 1;
     //ʹPIEж
+#if ADC_USE_DMA
+    IER |= M_INT7;//DMA CH1PIEIER7.INTx1DMACH1ModeConfigʹ
+#else
     PieCtrlRegs.PIEIER1.bit.INTx1 = 1;//ʹAdcint1ж
+#endif
     //PieCtrlRegs.PIEIER9.bit.INTx1 = 1;//ʹSciж
     //PieCtrlRegs.PIEIER1.bit.INTx4 = 1;//ʹⲿж
 
-    // Enable MTOCIPC INTn in the PIE: Group 11 interrupts
-    //PieCtrlRegs.PIEIER11.bit.INTx1 = 1; // MTOCIPC INT1
-    PieCtrlRegs.PIEIER11.bit.INTx2 = 1; // MTOCIPC INT2
-
 
     //ȫж
     EINT;//ʹȫжϣжϣCPUģ
@@ -92,26 +92,9 @@ void main(void)
 
     // Initialize all variables.
     ErrorFlag = 0;
-    wErrorFlag = 0;
-    for (counter = 0; counter < usMBuffer_SIZE; counter++)
-    {
-        usMBuffer[counter] = 0;
-    }
-    for (counter = 0; counter < usMBuffer_SIZE; counter++)
-    {
-        usCBuffer[counter] = 0;
-    }
-    // Point array to address in CTOM MSGRAM for passing variable locations
-    pulMsgRam = (void *)C28_CTOM_PASSMSG;
-
-    // Write addresses of variables where words should be written to pulMsgRam
-    // array.
-    pulMsgRam[2] = (unsigned long)&usMBuffer[0];
+    IpcRingInit();//˼ϢǰȰѱ˶˵׼
 
-
-    pulMsgRam = (void *)C28_MTOC_PASSMSG;
-
-    // Flag to M3 that the variables are ready in MSG RAM with CTOM IPC Flag 17
+    // Flag to M3 that the ring endpoint is ready with CTOM IPC Flag 17
     CtoMIpcRegs.CTOMIPCSET.bit.IPC17 = 1;
 
 
@@ -119,132 +102,14 @@ void main(void)
     while(1)
     {
 
-        if(IPC_get_flag)
+        if(IPC_RING_RX_PENDING())//M3¼¼
         {
+            IPC_RING_RX_ACK();
             IPCdata_tran();
-            IPC_get_flag=0;
-        }
-
-        n_coop++;
-        if(n_coop==30000)
-        {
-            int i=0;
-            for(i=0;i<44;i++)
-            {
-                IPC_send.all=Paramet[i];
-                usCBuffer[2*i]=IPC_send.bit.MEM1;
-                usCBuffer[2*i+1]=IPC_send.bit.MEM2;
-            }
-            ipc_to_pso_flag=1;
-            n_coop=0;
-        }
-
-
-        Paramet[0]=Ua;//ֵλ
-        Paramet[1]=Ub;
-        Paramet[2]=Uc;
-        Paramet[3]=P;
-        Paramet[4]=Q;
-        Paramet[5]=w;
-        Paramet[6]=theta_fan;
-///////////////////////////////////////////////////////////λ·
-        P0=Paramet[P_0];
-        Q0=Paramet[Q_0];
-        kp_current_dqp=Paramet[kp_I_p];
-        ki_current_dqp=Paramet[ki_I_p];
-        kp_current_dqn=Paramet[kp_I_n];
-        ki_current_dqn=Paramet[ki_I_n];
-        kp_voltage_dqp=Paramet[kp_u_p];
-        ki_voltage_dqp=Paramet[ki_u_p];
-        kp_voltage_dqn=Paramet[kp_u_n];
-        ki_voltage_dqn=Paramet[ki_u_n];
-        max_current=Paramet[PI_I_max];
-        kp_pcc_degree=Paramet[kp_pcc];
-        ki_pcc_degree=Paramet[ki_pcc];
-        min_current=-max_current;
-
-
-///////////////////////////////////////////////////////////
-        //Ƿͣ
-        if( FlagRegs.flagsystem.bit.sysonoff == 0)//ͣ
-        {
-            SYSTEMoff();
-        }
-        else
-        {
-            if(N_stage2==0)
-            {
-                PWMopen();
-            }
-            else
-            {
-                PWMoff();//PWM
-            }
         }
-
-
-        if(ipc_to_pso_flag)
-        {
-        // Data Block Writes
-            // Request Memory Access to S0 SARAM for C28 (Invokes
-            // IPCCtoMSetBits_Protected() function)
-            IPCCtoMReqMemAccess (&g_sIpcController2, S0_ACCESS, IPC_SX_C28MASTER,
-                                 ENABLE_BLOCKING);
-            while ((RAMRegs.CSxMSEL.all & S0_ACCESS) != S0_ACCESS)
-            {
-            }
-
-            // Write a block of data from C28 to S0 shared RAM which is then written to
-            // an M3 address.
-            for (counter = 0; counter < usMBuffer_SIZE; counter++)
-            {
-                pusCBufferPt[counter] = usCBuffer[counter];
-            }
-
-            IPCCtoMBlockWrite(&g_sIpcController2, pulMsgRam[2], (Uint32)pusCBufferPt,
-                              usMBuffer_SIZE, IPC_LENGTH_16_BITS,
-                              ENABLE_BLOCKING);
-
-            // Return Memory Access to S0 SARAM to M3 (Invokes
-            // IPCCtoMSetBits_Protected() function)
-            IPCCtoMReqMemAccess (&g_sIpcController2, S0_ACCESS, IPC_SX_M3MASTER,
-                                 ENABLE_BLOCKING);
-            while ((RAMRegs.CSxMSEL.all & S0_ACCESS) != 0)
-            {
-            }
-
-
-            // Read data back from M3.
-            IPCCtoMBlockRead(&g_sIpcController2, pulMsgRam[2], (Uint32)pusMBufferPt,
-                             usMBuffer_SIZE, ENABLE_BLOCKING,
-                             IPC_FLAG17);
-
-            // Wait until read data is ready (by checking IPC Response Flag is cleared).
-            // Then check for correct data.
-            while (CtoMIpcRegs.CTOMIPCFLG.bit.IPC17)
-            {
-            }
-
-            for (counter = 0; counter <usMBuffer_SIZE; counter++)
-            {
-                if (usCBuffer[counter] != pusMBufferPt[counter])
-                {
-                    wErrorFlag = 1;
-                }
-                else
-                {
-                    wErrorFlag = 0;
-                }
-            }
-
-            if (wErrorFlag == 1)
-            {
-                wErrorCount++;
-            }
-            ipc_to_pso_flag=0;
-        }
-
-
+        ParamSyncPoll();//λ¼ϺţҪM3ȫط
+        TlmService();//жץõ֡ParametдS0M3ֱӶ
+        CtrlBackground();
 
 
         // Flag an Error if an Invalid Command has been received.
@@ -258,6 +123,51 @@ void main(void)
 
 }
 
+//ѭͿйصĲ֣·̨У㡢ͣ
+//IPCS0(host/)ֱӵ
+void CtrlBackground(void)
+{
+//////////////////////////////////////////////////////λ·
+    P0=Paramet[P_0];
+    Q0=Paramet[Q_0];
+    kp_current_dqp=Paramet[kp_I_p];
+    ki_current_dqp=Paramet[ki_I_p];
+    kp_current_dqn=Paramet[kp_I_n];
+    ki_current_dqn=Paramet[ki_I_n];
+    kp_voltage_dqp=Paramet[kp_u_p];
+    ki_voltage_dqp=Paramet[ki_u_p];
+    kp_voltage_dqn=Paramet[kp_u_n];
+    ki_voltage_dqn=Paramet[ki_u_n];
+    max_current=Paramet[PI_I_max];
+    kp_pcc_degree=Paramet[kp_pcc];
+    ki_pcc_degree=Paramet[ki_pcc];
+    min_current=-max_current;
+    PIGainCommit();//б仯дPI
+    MODULATOR_MODE(&Modulator,(Uint16)Paramet[modulation]);
+    DELAY_COMP_MODE(&Delay_comp,(Uint16)Paramet[delay_comp]);
+    TlmDecim((Uint16)Paramet[tlm_decim]);
+    AdcZeroUpdate();//PWMڼ̨У
+
+
+//////////////////////////////////////////////////////
+    //Ƿͣ
+    if( FlagRegs.flagsystem.bit.sysonoff == 0)//ͣ
+    {
+        SYSTEMoff();
+    }
+    else
+    {
+        if(N_stage2==0)
+        {
+            PWMopen();
+        }
+        else
+        {
+            PWMoff();//PWM
+        }
+    }
+}
+
 ////SCIжϷӳ
 //interrupt void scirxintab_isr(void)
 //{
@@ -277,11 +187,22 @@ interrupt void xint1_isr(void)
 }
 
 
+//ӲPWMѾTZֻǹԴ
+interrupt void epwm1_tz_isr(void)
+{
+    HardwareFaultLatch();
+    PieCtrlRegs.PIEACK.all = PIEACK_GROUP2;
+}
+
+
 interrupt void adca1_interrupt_isr(void)
 {
-	GpioDataRegs.GPADAT.bit.GPIO14 = 1;
+	HAL_TEST_PIN(1);
+	PROF_START();
     Adcread();//ӳ
+    PROF_MARK(PROF_ADCREAD);
     Adcdeal();
+    PROF_MARK(PROF_ADCDEAL);
 
     //ǷУ
      if(FlagRegs.flagsystem.bit.AC0CheckFinished==1)//УѾ
@@ -302,32 +223,38 @@ interrupt void adca1_interrupt_isr(void)
           //--------------------------------------------------------
           /////////////
   //        	theta_fan=0;
+          //任ǶͳһȡTheta_context(neiwaihuan()theta_fan)
+#if PWM_DOUBLE_UPDATE
+          Ctrl_slow^=1;//һжһ
+#endif
           //------------------------------------е任
-          I_conversion.As=Adcget.Ia;
-          I_conversion.Bs=Adcget.Ib;
-          I_conversion.Cs=Adcget.Ic;
-          I_conversion.Angle=theta_fan;
-          abc_dq0p(&I_conversion);
-          Idp=I_conversion.Ds;
-          Iqp=I_conversion.Qs;
-          I_conversion.Angle=-theta_fan;
-          abc_dq0n(&I_conversion);
-          Idn=I_conversion.Ds;
-          Iqn=I_conversion.Qs;
+          I_conversion.As=NUM_IN(Adcget.Ia);
+          I_conversion.Bs=NUM_IN(Adcget.Ib);
+          I_conversion.Cs=NUM_IN(Adcget.Ic);
+          abc_dq0pn(&I_conversion,&Theta_context);
+          Idp=NUM_OUT(I_conversion.Dsp);
+          Iqp=NUM_OUT(I_conversion.Qsp);
+          Idn=NUM_OUT(I_conversion.Dsn);
+          Iqn=NUM_OUT(I_conversion.Qsn);
+#if PWM_DOUBLE_UPDATE||ADC_PIPELINE
+          CurrentFeedback();//˫£ÿж϶µķˮߣDDSRFõѹתʱ
+#endif
+          AdcVoltageStage();//ˮߣŵȵѹת
+#if PWM_DOUBLE_UPDATE
+          if(Ctrl_slow)
+          {
+#endif
 
 
           //------------------------------------˿ڵѹ
-          U_conversion.As=Adcget.Ua;
-          U_conversion.Bs=Adcget.Ub;
-          U_conversion.Cs=Adcget.Uc;
-          U_conversion.Angle=theta_fan;
-          abc_dq0p(&U_conversion);
-          Udp=U_conversion.Ds;
-          Uqp=U_conversion.Qs;
-          U_conversion.Angle=-theta_fan;
-          abc_dq0n(&U_conversion);
-          Udn=U_conversion.Ds;
-          Uqn=U_conversion.Qs;
+          U_conversion.As=NUM_IN(Adcget.Ua);
+          U_conversion.Bs=NUM_IN(Adcget.Ub);
+          U_conversion.Cs=NUM_IN(Adcget.Uc);
+          abc_dq0pn(&U_conversion,&Theta_context);
+          Udp=NUM_OUT(U_conversion.Dsp);
+          Uqp=NUM_OUT(U_conversion.Qsp);
+          Udn=NUM_OUT(U_conversion.Dsn);
+          Uqn=NUM_OUT(U_conversion.Qsn);
 
   //        //--------------------------------------PCC
   //        Io_conversion.As=Adcget.Ioa;
@@ -337,20 +264,26 @@ interrupt void adca1_interrupt_isr(void)
   //        abc_dq0p(&Io_conversion);
 
           //--------------------------------------PCCѹ
-          Uo_conversion.As=Adcget.Uoa;
-          Uo_conversion.Bs=Adcget.Uob;
-          Uo_conversion.Cs=Adcget.Uoc;
-          Uo_conversion.Angle=theta_fan;
-          abc_dq0p(&Uo_conversion);
-          Uodp=Uo_conversion.Ds;
-          Uoqp=Uo_conversion.Qs;
-          Uo_conversion.Angle=-theta_fan;
-          abc_dq0n(&Uo_conversion);
-          Uodn=Uo_conversion.Ds;
-          Uoqn=Uo_conversion.Qs;
+          Uo_conversion.As=NUM_IN(Adcget.Uoa);
+          Uo_conversion.Bs=NUM_IN(Adcget.Uob);
+          Uo_conversion.Cs=NUM_IN(Adcget.Uoc);
+          abc_dq0pn(&Uo_conversion,&Theta_context);
+          Uodp=NUM_OUT(Uo_conversion.Dsp);
+          Uoqp=NUM_OUT(Uo_conversion.Qsp);
+          Uodn=NUM_OUT(Uo_conversion.Dsn);
+          Uoqn=NUM_OUT(Uo_conversion.Qsn);
+#if PWM_DOUBLE_UPDATE
+          }
+#endif
+          PROF_MARK(PROF_PARK);
 
+#if PWM_DOUBLE_UPDATE
+          if(Ctrl_slow)
+#endif
           droop();
+          PROF_MARK(PROF_DROOP);
           neiwaihuan();
+          PROF_MARK(PROF_NEIWAIHUAN);
 
 
           //---------------------SPWM------------------------------------
@@ -369,9 +302,9 @@ interrupt void adca1_interrupt_isr(void)
   //        Ua=311*cos(theta_fan)+Uout_conversion.As;
   //        Ub=311*cos(theta_fan-TWObyTHREE*PI)+Uout_conversion.Bs;
   //        Uc=311*cos(theta_fan+TWObyTHREE*PI)+Uout_conversion.Cs;
-          Ua=311*cos(theta_fan)+Uout_conversion.As+Uoutn_conversion.As;
-          Ub=311*cos(theta_fan-TWObyTHREE*PI)+Uout_conversion.Bs+Uoutn_conversion.Bs;
-          Uc=311*cos(theta_fan+TWObyTHREE*PI)+Uout_conversion.Cs+Uoutn_conversion.Cs;
+          Ua=311*Delay_comp.Out.Cosine0+Uout_conversion.As+Uoutn_conversion.As;
+          Ub=311*Delay_comp.Out.Cosine1+Uout_conversion.Bs+Uoutn_conversion.Bs;
+          Uc=311*Delay_comp.Out.Cosine2+Uout_conversion.Cs+Uoutn_conversion.Cs;
   //-----------------------------------------
           a_graph[n_graph]=Ua;
           b_graph[n_graph]=Ub;
@@ -384,53 +317,23 @@ interrupt void adca1_interrupt_isr(void)
           	n_graph=0;
           }
 
-          //
-          if(Ua>M)//M
-          {
-              Ua=M;
-          }
-          if(Ua<-M)
-          {
-              Ua=-M;
-          }
-          //
-          if(Ub>M)
-          {
-              Ub=M;
-          }
-
-          if(Ub<-M)
-          {
-              Ub=-M;
-          }
-          //
-          if(Uc>M)
-          {
-              Uc=M;
-          }
-
-          if(Uc<-M)
-          {
-              Uc=-M;
-          }
-          m_sin_a=Ua/500;
-          m_sin_b=Ub/500;
-          m_sin_c=Uc/500;
-
-  //        Tcmpa=3750*(1-m_sin_a);
-  //        Tcmpb=3750*(1-m_sin_b);
-  //        Tcmpc=3750*(1-m_sin_c);
-          //T/4
-
-          //5kHz
-          Tcmpa=7500*(1-m_sin_a);
-          Tcmpb=7500*(1-m_sin_b);
-          Tcmpc=7500*(1-m_sin_c);
-
-
-          EPwm1Regs.CMPA.half.CMPA=Tcmpa;
-          EPwm2Regs.CMPA.half.CMPA=Tcmpb;
-          EPwm3Regs.CMPA.half.CMPA=Tcmpc;
+          //ע롢ơռձ
+          Modulator.Ua=Ua;
+          Modulator.Ub=Ub;
+          Modulator.Uc=Uc;
+          Modulator.Ia=Adcget.Ia;
+          Modulator.Ib=Adcget.Ib;
+          Modulator.Ic=Adcget.Ic;
+          MODULATOR_CALC(&Modulator);
+          m_sin_a=Modulator.Ma;
+          m_sin_b=Modulator.Mb;
+          m_sin_c=Modulator.Mc;
+          Tcmpa=Modulator.Cmpa;
+          Tcmpb=Modulator.Cmpb;
+          Tcmpc=Modulator.Cmpc;
+          HAL_PWM_CMPA(Tcmpa,Tcmpb,Tcmpc);
+          PROF_LATENCY();
+          PROF_MARK(PROF_SPWM);
 
 //		if(n_count1==vn_comp)
 //		{
@@ -451,35 +354,36 @@ interrupt void adca1_interrupt_isr(void)
 
     }
 
-	Adc1Regs.ADCINTFLGCLR.bit.ADCINT1 = 1;  //Clear ADCINT1 flag reinitialize
-	                                            // for next SOC
-    PieCtrlRegs.PIEACK.all = PIEACK_GROUP1;
-    GpioDataRegs.GPADAT.bit.GPIO14 = 0;
+    AdcVoltageStage();//ûʱѹҲҪУҪ֡
+    TLM_SAMPLE();//ȡץв
+
+	HAL_ADC_ISR_ACK();  //Clear ADCINT1 flag reinitialize
+	                    // for next SOC
+    PROF_END();
+    HAL_TEST_PIN(0);
 }
 
 
 
+//M3ļ¼
 void IPCdata_tran(void)
 {
-    PackLength=usMBuffer[0];
-    SerialNumber=usMBuffer[1];
-    CommandCode=usMBuffer[2];
+    IPC_REC rec;
 
-    if(PackLength==5&&CommandCode==0xB1)//Ƿ5-жϿػ
-    {
-        Data_get.bit.MEM1=usMBuffer[3];
-        Data_get.bit.MEM2=usMBuffer[4];
-        Switchsystem=Data_get.all;
-    }
-    if(PackLength==7)//Ƿ7//Ǵӻʾ޸ҪǶӦĴӻ
+    while(IpcRingPop(&rec))
     {
-        FData_get.bit.MEM1=usMBuffer[3];
-        FData_get.bit.MEM2=usMBuffer[4];
-        FData_get.bit.MEM3=usMBuffer[5];
-        FData_get.bit.MEM4=usMBuffer[6];
-        Paramet[SerialNumber]=FData_get.all;
+        switch(rec.Tag)
+        {
+        case IPC_REC_SWITCH://ػ
+            Switchsystem=rec.Arg;
+            break;
+        case IPC_REC_PARAM://ǴӻĲͬ
+            ParamSyncApply(&rec);
+            break;
+        default:
+            break;
+        }
     }
-
 }
 
 
@@ -539,34 +443,3 @@ Error(void)
 //    PieCtrlRegs.PIEACK.all = PIEACK_GROUP11;
 //}
 
-//*****************************************************************************
-// MtoC INT2 Interrupt Handler - Handles Data Block Reads/Writes
-//*****************************************************************************
-__interrupt void
-MtoCIPC2IntHandler (void)
-{
-    tIpcMessage sMessage;
-
-    // Continue processing messages as long as MtoC GetBuffer2 is full
-    while (IpcGet (&g_sIpcController2, &sMessage,
-                   DISABLE_BLOCKING)!= STATUS_FAIL)
-    {
-        switch (sMessage.ulcommand)
-        {
-        case IPC_BLOCK_WRITE:
-            IPCMtoCBlockWrite(&sMessage);
-            break;
-        case IPC_BLOCK_READ:
-            IPCMtoCBlockRead(&sMessage);
-            break;
-        default:
-            ErrorFlag = 1;
-            break;
-        }
-    }
-    IPC_get_flag=1;
-    // Acknowledge IPC INT2 Flag and PIE to receive more interrupts from group
-    // 11
-    CtoMIpcRegs.MTOCIPCACK.bit.IPC2 = 1;
-    PieCtrlRegs.PIEACK.all = PIEACK_GROUP11;
-}
@@ -8,8 +8,13 @@
 #ifndef ADC_SELF_H_
 #define ADC_SELF_H_
 
-#define ADCZeroCNT0num 600//Уÿѭ
-#define ADCZeroCNTloopnum 8 //Уѭ
+//------------------------------------------̨У
+//PWMڼһֱУ㣺жֻÿ·ۼADC_ZERO_BLOCK㣬һ齻̨
+//ֵ̨һָƽжAdcdealͷһοAC_ZeroMean
+//ͨ12·ƫʼͬһ档鳤ȡƵڣѹҲƽ
+#define ADC_ZERO_BLOCK CTRL_ISR_TICKS(0.1)//ÿ100ms550Hz
+#define ADC_ZERO_SHIFT 3  //ֵָƽϵ1/8ʱ䳣Լ0.8s
+#define ADC_ZERO_FRAC  4  //ֵ4λС
 
 typedef struct{float Ia;
                float Ib;
@@ -37,8 +42,120 @@ typedef struct{float Ia;
 	                                  0,0,0,\
 	                                  0,0,0}
 
+//------------------------------------------˫ADCͬ
+//010·ȫADC1˳ת
+//1ADC1ADC25SOCͬһADCTRIG5(EPWM1SOCA)kͬʱ
+//   Ia/IbUa/UbIoa/Iobͬһתȼ롣ҪϰADC2һźŽӵADC2ͬ
+#define ADC_DUAL 0
+#define ADC_STEP_NUM    5//˫ADCʱÿADCSOC
+#define ADC2_RESULT_BASE ADC_STEP_NUM//֡ADC2ʼλãRESULT0~4ADC15~9ADC2
+
+#if ADC_DUAL
+//      ADC1         ADC2
+//0       Ia(A0)       Ib(A2)
+//1       Ic(A3)       Uc(A7)
+//2       Ua(A4)       Ub(A6)
+//3       Ioa(B0)      Iob(B3)
+//4       Ioc(B4)      Uoa(B7)
+//Ҫڵ01ת(ˮ)Icֻܺһ·ѹԣȡUc
+#define ADC1_CH_MAP {0,3,4,8,12}
+#define ADC2_CH_MAP {2,7,6,11,15}
+//ADCresult[i]֡еλ
+#define ADC_SLOT_IA  0
+#define ADC_SLOT_IB  (ADC2_RESULT_BASE+0)
+#define ADC_SLOT_IC  1
+#define ADC_SLOT_UC  (ADC2_RESULT_BASE+1)
+#define ADC_SLOT_UA  2
+#define ADC_SLOT_UB  (ADC2_RESULT_BASE+2)
+#define ADC_SLOT_IOA 3
+#define ADC_SLOT_IOB (ADC2_RESULT_BASE+3)
+#define ADC_SLOT_IOC 4
+#define ADC_SLOT_UOA (ADC2_RESULT_BASE+4)
+#define ADC_LAST_SOC (ADC_STEP_NUM-1)//ͬʱADC1EOCADCINT1
+#define ADC_PIPE_SOC 1//ڵ01ת
+#else
+#define ADC_SLOT_IA  0
+#define ADC_SLOT_IB  1
+#define ADC_SLOT_IC  2
+#define ADC_SLOT_UA  3
+#define ADC_SLOT_UB  4
+#define ADC_SLOT_UC  5
+#define ADC_SLOT_IOA 6
+#define ADC_SLOT_IOB 7
+#define ADC_SLOT_IOC 8
+#define ADC_SLOT_UOA 9
+#define ADC_LAST_SOC 9//һSOCEOCADCINT1
+#define ADC_PIPE_SOC 2//SOC0~2
+#endif
+
+//------------------------------------------DMAƹҲ
+//1ADCINT1DMA CH1֡ƹһ壬жϹDMA CH1жϣ
+//   жϿʼʱõһͬһ֡0ADCINT1жֱӶĴ
+#define ADC_USE_DMA 0
+//ÿ֡ADC1ֻ10ⲿ(A0A2~A4A6A7B0B3B4B7)ȫIa~Uoaϣ
+//UobUocûADCADCresult[10][11]һֱ0
+#define ADC_FRAME_NUM 10
+
+typedef struct{Uint16 Ready;//жõĻ
+               Uint16 Frame;//Ѵ֡
+               Uint16 Late;//жϽʱһ֡Ѿ(Ƴʱ)
+               Uint16 DmaOvr;//DMAһδû
+              }ADC_FRAME;
+#define ADC_FRAME_DEFAULTS {0,0,0,0}
+
+#if ADC_USE_DMA
+ extern Uint16 Adc_dma_buf[2][ADC_FRAME_NUM];
+ extern ADC_FRAME Adc_frame;
+ extern void ConfigureAdcDma(void);
+ extern void AdcFrameSwap(void);
+ extern void AdcFrameEnd(void);
+#endif
+
+//------------------------------------------ˮ߲
+//1תǰADCINT1һ·(ADC_PIPE_SOC)EOCϣ
+//   жһ任DDSRF룬ʱѹת
+//   ADCINT2ADC_LAST_SOCϡPIEAdcVoltageStage鵽λٶѹѹ֡
+//   ֡DMAҪȫתŰᣬ߲ͬʱ
+//0ADCINT1ADC_LAST_SOCϣжʱ֡ת
+#define ADC_PIPELINE 0
+#define ADC_PIPE_SPIN_MAX 2000//ȵѹѯ˼ǳʱһ֡ѹ
+
+#if ADC_PIPELINE&&ADC_USE_DMA
+#error "ADC_PIPELINE needs ADC_USE_DMA=0"
+#endif
+
+typedef struct{Uint16 Done;//֡ѹѴ
+               Uint16 Spin;//֡ȵѹѯ
+               Uint16 SpinMax;
+               Uint16 Timeout;//ȵѹʱ
+               Uint16 Stale;//һ֡ʱADCINT2һ֡ͷ
+              }ADC_PIPE;
+#define ADC_PIPE_DEFAULTS {0,0,0,0,0}
+
+#if ADC_PIPELINE
+ extern ADC_PIPE Adc_pipe;
+ extern void AdcVoltageStage(void);
+#else
+#define AdcVoltageStage()//֡һδûеڶ
+#endif
+
+typedef struct{Uint32 Sum[12];//жۼ
+               Uint32 Block[12];//һ飬̨
+               Uint32 Mean[12];//ָ̨ƽQ4
+               Uint32 Next[12];//ƫ
+               Uint16 Cnt;//ǰۼӵ
+               volatile Uint16 BlockReady;//1Block̨жą̃壩
+               volatile Uint16 Publish;//1Next̨ãж壩
+               Uint16 Skip;//1ͣһȵ˥
+               Uint16 Blocks;//Ѵ0ʾMeanûֵ
+               Uint16 Drop;//̨ûüĿ
+              }ADC_ZERO;
+#define ADC_ZERO_DEFAULTS {{0},{0},{0},{0},0,0,0,0,0,0}
+
 //ṹ
  extern ADC_VOLT_CURRENT_GET Adcget;
+ extern ADC_ZERO Adc_zero;
+ extern void AdcZeroUpdate(void);//̨У㣬ѭ
  extern void Adcdeal(void);//ADC
  extern void Adcread(void);//ADCȡ
  extern void ADCzero(void);
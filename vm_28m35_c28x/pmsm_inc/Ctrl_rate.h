@@ -0,0 +1,49 @@
+/*
+ * Ctrl_rate.h
+ *
+ *  Ƶʣ(ز)Ƶʣֻ
+ *  PWMڡT˲ϵPIͰļʱ䶼CTRL_FSƳ
+ */
+
+#ifndef CTRL_RATE_H_
+#define CTRL_RATE_H_
+
+#define CTRL_FS      5000//Ƶ(Hz)ȡ5000/10000/20000
+#define CTRL_TBCLK   150000000L//TBCLK=SYSCLKOUT(HSPCLKDIV=CLKDIV=0)
+#define CTRL_PWM_PRD (CTRL_TBCLK/CTRL_FS/2)//TBPRD5kHzʱ15000
+#define PWM_DEADBAND 200//DBRED/DBFED(TBCLK)200Ӧ1.33us
+#define CTRL_T       (1.0/CTRL_FS)//(s)
+
+//------------------------------------------˫
+//1EPWM1~3CTR=0CTR=PRDSOCAװCMPAжÿزڽΣ
+//   ͵ÿж϶(컷)ѹ´DDSRF˲һ(ΪCTRL_FS)
+//   ʱ룬Ƶʲ
+//0ÿزڲװһΣ컷CTRL_FS
+#define PWM_DOUBLE_UPDATE 0
+#define CTRL_ISR_FS  (CTRL_FS*(PWM_DOUBLE_UPDATE+1))//жƵ
+#define CTRL_ISR_T   (1.0/CTRL_ISR_FS)//ж(s)
+
+//tӦж
+#define CTRL_TICKS(t)     ((Uint32)((t)*CTRL_FS+0.5))
+#define CTRL_ISR_TICKS(t) ((Uint32)((t)*CTRL_ISR_FS+0.5))
+
+//λ·ki5kHzµÿĻ棬CTRL_FSʱϵʱ䳣
+#define CTRL_FS_REF   5000
+#define CTRL_KI_SCALE ((float)CTRL_FS_REF/CTRL_FS)//ѹ()
+#define CTRL_KI_SCALE_FAST ((float)CTRL_FS_REF/CTRL_ISR_FS)//(컷)
+
+//------------------------------------------Butterworthͨ
+//˫Ա任ֹƵԤK=tan(Сfc/fs)fc<<fstanȡ5ʱ
+#define CTRL_PI       3.141592654
+#define CTRL_SQRT2    1.414213562
+#define LPF2_W(fc)    (CTRL_PI*(fc)/CTRL_FS)
+#define LPF2_K(fc)    (LPF2_W(fc)+LPF2_W(fc)*LPF2_W(fc)*LPF2_W(fc)/3+2*LPF2_W(fc)*LPF2_W(fc)*LPF2_W(fc)*LPF2_W(fc)*LPF2_W(fc)/15)
+#define LPF2_KK(fc)   (LPF2_K(fc)*LPF2_K(fc))
+#define LPF2_N(fc)    (1.0/(1+CTRL_SQRT2*LPF2_K(fc)+LPF2_KK(fc)))
+#define LPF2_A1(fc)   (LPF2_KK(fc)*LPF2_N(fc))//X
+#define LPF2_A2(fc)   (2*LPF2_A1(fc))//X_last
+#define LPF2_A3(fc)   LPF2_A1(fc)//X_last1
+#define LPF2_B1(fc)   (2*(LPF2_KK(fc)-1)*LPF2_N(fc))//Y_last
+#define LPF2_B2(fc)   ((1-CTRL_SQRT2*LPF2_K(fc)+LPF2_KK(fc))*LPF2_N(fc))//Y_last1
+
+#endif /* CTRL_RATE_H_ */
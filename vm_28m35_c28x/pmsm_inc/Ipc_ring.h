@@ -0,0 +1,68 @@
+/*
+ * Ipc_ring.h
+ *
+ *  ˼ϢCTOMRAMMTOCRAMһߵ߻
+ *  ÿֻдԼͷǿϢRAMȨȶԷ
+ */
+
+#ifndef IPC_RING_H_
+#define IPC_RING_H_
+
+//------------------------------------------(16λ)
+//ÿϢRAMIPC_RING_OFSʼдRAMǸ˵Ķ˵㣺
+//  [0] Magic  ˵ʼдIPC_RING_MAGICԷ
+//  [1] Head   ˷ͻдţֻбд
+//  [2] Tail   Էͻ(ڶԷϢRAM)Ķţֻбд
+//  [3] 
+//  [4..]      ˷ͻIPC_RING_NUM¼ÿIPC_REC_WORDS֣
+//             Tag Arg D0 D1 Seq CrcCrcǰ5ֵCRC16Բϵļ¼շ
+//16λɼλ±꣬Head-Tailǻļ¼
+//д¼ƽHeadȶ¼ƽTailԷָļ¼
+//M3self/ipc_ring.hͬĲ֣һ
+#define IPC_RING_OFS    0x200//ǰIPCPUTBUFFERȣļϢRAMֻ䵽
+#define IPC_RING_MAGIC  0x5AA5
+#define IPC_RING_NUM    64//¼2
+#define IPC_REC_WORDS   6
+#define IPC_RING_HDR    4
+
+#define IPC_RING_TX_BASE (0x03F800+IPC_RING_OFS)//CTOMRAMC28д
+#define IPC_RING_RX_BASE (0x03FC00+IPC_RING_OFS)//MTOCRAMC28ֻ
+
+//CRC16ʽ0x1021ֵ0䣬ÿȵֽںֽڣ
+//M3uCRCUCRC_CONFIG_CRC16_2ڴֽ˳һ
+#define IPC_CRC_REC     5//¼CRC
+
+//壺һһIPC5Էѭ鵽Ӧٰѻգ
+//Ӧ֮ļ¼λ©IPC5ж
+#define IPC_RING_DOORBELL()   {CtoMIpcRegs.CTOMIPCSET.bit.IPC5=1;}
+#define IPC_RING_RX_PENDING() (CtoMIpcRegs.MTOCIPCSTS.bit.IPC5)
+#define IPC_RING_RX_ACK()     {CtoMIpcRegs.MTOCIPCACK.bit.IPC5=1;}
+
+//¼
+#define IPC_REC_PARAM  1//Arg=Paramet±꣬D0/D1=/16λSeq=ͬţM3C28
+#define IPC_REC_SWITCH 2//Arg=SwitchsystemM3C28
+#define IPC_REC_SYNC   3//C28ҪM3Ѳȫطһ飬C28M3
+
+typedef struct{Uint16 Tag;
+               Uint16 Arg;
+               Uint16 D0;
+               Uint16 D1;
+               Uint16 Seq;
+              }IPC_REC;
+
+typedef struct{Uint16 Push;//ѷ¼
+               Uint16 Drop;//Էûûȥļ¼
+               Uint16 Pop;//ռ¼
+               Uint16 Bad;//Էųһ(Էλ)¶Ĵ
+               Uint16 Crc;//CRCԶļ¼
+              }IPC_RING_STAT;
+#define IPC_RING_STAT_DEFAULTS {0,0,0,0,0}
+
+extern IPC_RING_STAT Ipc_ring;
+extern void IpcRingInit(void);
+extern Uint16 IpcRingFree(void);
+extern Uint16 IpcRingPush(Uint16 tag,Uint16 arg,Uint16 d0,Uint16 d1,Uint16 seq);
+extern Uint16 IpcRingPop(IPC_REC *r);
+extern Uint16 IpcCrc16(const volatile Uint16 *p,Uint16 words);
+
+#endif /* IPC_RING_H_ */
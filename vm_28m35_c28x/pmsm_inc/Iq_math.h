@@ -0,0 +1,28 @@
+/*
+ * Iq_math.h
+ *
+ *  Num_type.hIQ24õIQmathӼ_iq_IQ_IQmpy_IQtoF
+ *  TI IQmathLib.hͬһ(_IQضϣ_IQmpyȡ64λGLOBAL_Q)
+ *  IQmath.libҲIQmathTablesҪ_IQsin_IQdivЩٻTIIQmathLib.h
+ *  C28_IQmpyǱڽ__IQmpy(HOST_BUILD)64λ˷
+ */
+
+#ifndef IQ_MATH_H_
+#define IQ_MATH_H_
+
+#ifndef GLOBAL_Q
+#define GLOBAL_Q 24
+#endif
+
+typedef int32 _iq;
+
+#define _IQ(A)      ((_iq)((A)*(float64)(1L<<GLOBAL_Q)))
+#define _IQtoF(A)   ((float)(A)*(1.0f/(1L<<GLOBAL_Q)))
+
+#ifdef HOST_BUILD
+#define _IQmpy(A,B) ((_iq)(((int64)(A)*(B))>>GLOBAL_Q))
+#else
+#define _IQmpy(A,B) __IQmpy(A,B,GLOBAL_Q)
+#endif
+
+#endif /* IQ_MATH_H_ */
@@ -0,0 +1,72 @@
+/*
+ * Modulator.h
+ *
+ *  ƣѹռձȡCMPA
+ *  SPWMֱӰƣMINMAXע-(max+min)/2SVPWMЧߵѹֵɵֱĸߵѹ
+ *  SPWMԼ15%ʱƷʽ
+ *  ԲдCMPA
+ */
+
+#ifndef MODULATOR_H_
+#define MODULATOR_H_
+
+#define MOD_SPWM   0//ҵ
+#define MOD_MINMAX 1//min-maxע(SVPWMЧ)
+
+#define MOD_OVM_CLAMP 0//ʱ൥޷ֵߵѹ
+#define MOD_OVM_SCALE 1//ʱȱСֵѹʸ
+
+#define MOD_PWM_PRD CTRL_PWM_PRD//EPWM1~3TBPRD()
+
+//------------------------------------------
+//ű(>0)ʱ¹ܶÿزTdĸߵƽCMPATd/2أ
+//ʱ෴ȡһ˲|i|<MOD_DT_IBANDʱɣ
+//˲ͺ(1-KF)/KFģCMPAЧе1.5ģǰôģ
+//ʱ50HzԼ11㣬5гֻܲ(host/test_dtc.c)
+#define MOD_DT_CMP   (PWM_DEADBAND*0.5)//ʱCMPA
+#define MOD_DT_IBAND 2.0//(A)
+#define MOD_DT_FC    500//˲ֹƵ(Hz)
+#define MOD_DT_KF    (2*CTRL_PI*MOD_DT_FC/CTRL_ISR_FS)//һ˲ϵ
+#define MOD_DT_LEAD  ((1-MOD_DT_KF)/MOD_DT_KF+1.5)//Գǰ
+
+typedef struct {  float  Ua;//룺ѹ(V)
+				  float  Ub;
+				  float  Uc;
+				  float  Kdc;//1/ĸߵѹĸߵѹƱ1Ӧѹ
+				  float  Mmax;//Ʊޣ<1ʱС
+				  Uint16 Mode;//MOD_SPWM/MOD_MINMAX
+				  Uint16 Ovm;//MOD_OVM_CLAMP/MOD_OVM_SCALE
+				  Uint16 Dtc;//1
+				  float  Ia;//룺(A)űΪ
+				  float  Ib;
+				  float  Ic;
+				  float  Ifa;//˲
+				  float  Ifb;
+				  float  Ifc;
+				  float  Ma;//Ʊ[-Mmax,Mmax]
+				  float  Mb;
+				  float  Mc;
+				  float  V0;//ע()
+				  Uint16 Cmpa;//CMPA
+				  Uint16 Cmpb;
+				  Uint16 Cmpc;
+				  Uint16 Overmod;//Ƶ
+		 	 	} MODULATOR;
+
+//MODULATOR_handleΪMODULATORָ
+typedef MODULATOR*MODULATOR_handle;
+//ʼM=500ӦƱ1SPWM+޷ԭISRһ
+#define MODULATOR_DEFAULTS {0,0,0,\
+	                        1.0/M,1.0,\
+	                        MOD_SPWM,MOD_OVM_CLAMP,0,\
+	                        0,0,0,0,0,0,\
+	                        0,0,0,0,\
+	                        MOD_PWM_PRD/2,MOD_PWM_PRD/2,MOD_PWM_PRD/2,\
+	                        0}
+
+void MODULATOR_CALC(MODULATOR_handle);
+void MODULATOR_MODE(MODULATOR_handle,Uint16);
+
+extern MODULATOR Modulator;
+
+#endif /* MODULATOR_H_ */
@@ -0,0 +1,47 @@
+/*
+ * Num_type.h
+ *
+ *  ƺ(任PI˲顢DDSRF)ֵ
+ */
+
+#ifndef NUM_TYPE_H_
+#define NUM_TYPE_H_
+
+//0float32FPU1IQ24㣬Iq_math.hҪIQmath.lib
+//Ҳڱѡ-DNUM_USE_IQ=1ָһݶԱȣhost/bench_num.c
+#ifndef NUM_USE_IQ
+#define NUM_USE_IQ 0
+#endif
+
+//IQ24ֻС128̣ѹ֮ǰͳһNUM_IQ_SCALE(̡65536ֱ3e-5)
+//ٳ˻ڶ㣬桢ϵЩٵ
+#define NUM_IQ_SCALE 512
+
+//˷ͽ˵Ĵ(host/bench_num.c)NUM_Kڳʼ
+#ifdef NUM_COUNT
+extern Uint32 Num_mpy_cnt;
+extern Uint32 Num_cvt_cnt;
+#define NUM_CNT_MPY   Num_mpy_cnt++,
+#define NUM_CNT_CVT   Num_cvt_cnt++,
+#else
+#define NUM_CNT_MPY
+#define NUM_CNT_CVT
+#endif
+
+#if NUM_USE_IQ
+#define GLOBAL_Q 24
+#include "Iq_math.h"
+typedef _iq num_t;
+#define NUM_K(x)      _IQ(x)                                      //٣ϵ桢
+#define NUM_IN(x)     (NUM_CNT_CVT _IQ((x)*(1.0/NUM_IQ_SCALE)))   //
+#define NUM_OUT(x)    (NUM_CNT_CVT _IQtoF(x)*NUM_IQ_SCALE)        //
+#define NUM_MPY(a,b)  (NUM_CNT_MPY _IQmpy(a,b))
+#else
+typedef float num_t;
+#define NUM_K(x)      (x)
+#define NUM_IN(x)     (NUM_CNT_CVT (x))
+#define NUM_OUT(x)    (NUM_CNT_CVT (x))
+#define NUM_MPY(a,b)  (NUM_CNT_MPY (a)*(b))
+#endif
+
+#endif /* NUM_TYPE_H_ */
@@ -0,0 +1,23 @@
+/*
+ * Param_sync.h
+ *
+ *  ͬնˣM3ֻλĹParamet(±,ֵ,)
+ *  ŶԲϻ򱾺˸ոλҪM3ѸĹĿȫطһ顣
+ *  Ͷ˼M3self/param_sync.h
+ */
+
+#ifndef PARAM_SYNC_H_
+#define PARAM_SYNC_H_
+
+typedef struct{Uint16 Seq;//һӦյ
+               Uint16 Need;//ҪM3ȫطIPC_REC_SYNC
+               Uint16 Rx;//յ
+               Uint16 Gap;//ŶԲϵĴ
+              }PARAM_SYNC;
+#define PARAM_SYNC_DEFAULTS {0,1,0,0}//ϵҪһȫ
+
+extern PARAM_SYNC Param_sync;
+extern void ParamSyncApply(const IPC_REC *r);
+extern void ParamSyncPoll(void);
+
+#endif /* PARAM_SYNC_H_ */
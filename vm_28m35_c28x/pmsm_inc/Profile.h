@@ -0,0 +1,73 @@
+/*
+ * Profile.h
+ *
+ *  жϷֶμʱCPUʱ1ֻڶISR_PROFILEĹ(Debug)
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+//adca1_interrupt_isrֶ
+#define PROF_ADCREAD    0//Adcread
+#define PROF_ADCDEAL    1//Adcdeal
+#define PROF_PARK       2//·abc_dq0pn
+#define PROF_DROOP      3//droop
+#define PROF_NEIWAIHUAN 4//neiwaihuan
+#define PROF_SPWM       5//Ʋ޷CMPA
+#define PROF_STAGE_NUM  6
+
+//ֱͼ8ÿ256(150MHzԼ1.7us)һи
+#define PROF_HIST_NUM   8
+#define PROF_HIST_SHIFT 8
+#define PROF_WINDOW     CTRL_ISR_TICKS(1.0)//1sһƽ
+#define PROF_US_PER_CYCLE (CPU_RATE/1000)//ÿڶus
+
+//Paramet[30..41]ηŸεƽ(us)Paramet[42]ж(us)
+//Paramet[43]дCMPAʱ(us)Paramet[0..43]IPCM3
+//MinHist[]ֻڷ￴Isr_profS0ֻParamet[0..43]λֻʣ8~10
+#define PROF_PARAMET_BASE  30
+#define PROF_PARAMET_TOTAL 42
+#define PROF_PARAMET_LATENCY 43
+
+typedef struct {  Uint32 Min;//
+                  Uint32 Max;
+                  Uint32 Sum;//ۼ
+                  Uint16 N;//ͣʱPARKȶβִУܰڳƽ
+                  float  Mean;//һڵƽ
+                  Uint16 Hist[PROF_HIST_NUM];
+                } PROF_STAGE;
+
+typedef struct {  Uint32 Mark;//һֶεĶʱֵ
+                  Uint32 Entry;//жʱĶʱֵ
+                  Uint32 TotalMax;
+                  Uint16 Count;
+                  Uint16 Clear;//1һͳ
+                  PROF_STAGE Stage[PROF_STAGE_NUM];
+                  PROF_STAGE Latency;//㵽дCMPAPWM㣬жǰĵȴ
+
+                } ISR_PROF;
+
+#ifdef ISR_PROFILE
+extern ISR_PROF Isr_prof;
+
+void ProfileInit(void);
+void ProfileMark(Uint16);
+void ProfileLatency(void);
+void ProfileEnd(void);
+void ProfilePublish(void);
+
+//CPUʱ1¼ζ֮
+#define PROF_START() {Isr_prof.Mark=CpuTimer1Regs.TIM.all;Isr_prof.Entry=Isr_prof.Mark;}
+#define PROF_MARK(s) ProfileMark(s)
+#define PROF_LATENCY() ProfileLatency()
+#define PROF_END()   ProfileEnd()
+#else
+#define ProfileInit()
+#define ProfilePublish()
+#define PROF_START()
+#define PROF_MARK(s)
+#define PROF_LATENCY()
+#define PROF_END()
+#endif
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Tlm_mirror.h
+ *
+ *  вS0RAM̶C28дM3ֻ
+ *  C28˫ҳдд귢ţM3ֱS0Ϣ
+ */
+
+#ifndef TLM_MIRROR_H_
+#define TLM_MIRROR_H_
+
+//------------------------------------------(16λ)
+//  [0] Magic  һҳддTLM_MAGICM3þ
+//  [1] Seq    ѷţSeq&1ǵǰЧҳ
+//  [2..3] 
+//  [4..]      ҳÿҳTLM_PAGE_WORDS֣[0]ҳ [1]CRC16(IpcCrc16)
+//             [2..]TLM_NUM
+//C28ֻдSeq+1ӦҳдƽSeqM3ҳ֮ǰᱻģ
+//M3ǰȡһSeqһ˵м䷢ΣضSeqûCRCԲݻˡ
+//M3self/tlm_mirror.hͬĲ֣һ
+#define TLM_BASE        C28_S0SARAM_START
+#define TLM_MAGIC       0xA55A
+#define TLM_NUM         44//Paramet[0..43]״̬
+#define TLM_HDR         4
+#define TLM_PAGE_WORDS  (2+2*TLM_NUM)//ż֤M34ֽڶ
+
+//------------------------------------------жϳȡ
+//жÿTLM_DECIMץһ֡Paramet[0..TLM_SNAP_NUM-1]Ӧı
+//һֵ֡ͬһжϣѭֻ֡Parametٷ
+//ÿһξһ֡Seq*Decimǲʱ(жϴ)
+#define TLM_FS          100//Ƶ(Hz)
+#define TLM_DECIM       (CTRL_ISR_FS/TLM_FS)
+#define TLM_SNAP_NUM    7//Ua Ub Uc P Q w theta_fan
+
+typedef struct{Uint16 Seq;//ѷ
+               Uint16 Skip;//S0ûC28Ĵ
+              }TLM_MIRROR_STAT;
+#define TLM_MIRROR_STAT_DEFAULTS {0,0}
+
+typedef struct{Uint32 Count;//жϴ
+               Uint16 Decim;//ȡȣλParamet[tlm_decim]߸
+               Uint16 Tick;//ȡ
+               Uint16 Ready;//1һ֡ѭᣬ֮ǰжϲд
+               Uint16 Lost;//ѭûüᣬ֡
+               Uint32 Stamp;//ǰ֡жϴ
+               float  Val[TLM_SNAP_NUM];
+              }TLM_SNAP;
+#define TLM_SNAP_DEFAULTS {0,TLM_DECIM,0,0,0,0,{0}}
+
+//жĩβãץ֡ʱֻμһ
+#define TLM_SAMPLE()  {Tlm_snap.Count++;\
+                       if(++Tlm_snap.Tick>=Tlm_snap.Decim){Tlm_snap.Tick=0;TlmCapture();}}
+
+extern TLM_MIRROR_STAT Tlm_mirror;
+extern TLM_SNAP Tlm_snap;
+extern void TlmPublish(void);
+extern void TlmCapture(void);
+extern void TlmService(void);
+extern void TlmDecim(Uint16 d);
+
+#endif /* TLM_MIRROR_H_ */
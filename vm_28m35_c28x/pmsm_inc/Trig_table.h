@@ -0,0 +1,38 @@
+/*
+ * Trig_table.h
+ *
+ *  Ҳ
+ */
+
+#ifndef TRIG_TABLE_H_
+#define TRIG_TABLE_H_
+
+//1ƻеSIN/COSRAM+Բֵ0RTSsin/cos
+#define TRIG_USE_TABLE 1
+
+//256/ڣԲֵԼh*h/8=7.5e-5(h=2/256)
+//С12λADC1LSB(2.4e-4)128ͳˣ5kHz50Hzÿת0.0628radԼ2.6
+//ĶԱȺhost/bench_trig.c
+#define TRIG_TABLE_BITS 8
+#define TRIG_TABLE_SIZE (1<<TRIG_TABLE_BITS)
+#define TRIG_TABLE_MASK (TRIG_TABLE_SIZE-1)
+#define TRIG_TABLE_QUARTER (TRIG_TABLE_SIZE/4)
+
+extern float Sin_table[TRIG_TABLE_SIZE+1];//һ㣬ֵʱȡģ
+
+void InitTrigTable(void);
+float Trig_sin(float);
+float Trig_cos(float);
+void Trig_sincos(float,float*,float*);
+
+#if TRIG_USE_TABLE
+#define SIN(x) Trig_sin(x)
+#define COS(x) Trig_cos(x)
+#define SINCOS(x,s,c) Trig_sincos(x,s,c)
+#else
+#define SIN(x) sin(x)
+#define COS(x) cos(x)
+#define SINCOS(x,s,c) {*(s)=sin(x);*(c)=cos(x);}
+#endif
+
+#endif /* TRIG_TABLE_H_ */
@@ -10,6 +10,8 @@
 
 
 //--------------------ṹ-----------------------------------
+//任PI˲顢/DDSRF״̬num_t(Num_type.h)
+//ЩṹNUM_IN/NUM_OUTתΪfloat
 
 //任
 
@@ -75,6 +77,100 @@ void abc_dq0p(CLARKE_PARK_handle);
 void iabc_dq0p(CLARKE_PARK_handle);
 void abc_dq0n(CLARKE_PARK_handle);
 void iabc_dq0n(CLARKE_PARK_handle);
+
+//------------------------------------------Ƕ
+//ÿֻһsin/cos1202ɺͽǹʽõ
+//任(-)ֱӸͬһֵ任ͽ
+typedef struct {  float  Angle;
+				  float  Sine0;		//sin()
+				  float  Sine1;		//sin(-120)
+				  float  Sine2;		//sin(+120)
+				  float  Cosine0;	//cos()
+				  float  Cosine1;	//cos(-120)
+				  float  Cosine2;	//cos(+120)
+				  float  Sine2x;	//sin(2)
+				  float  Cosine2x;	//cos(2)
+		 	 	} ANGLE_CONTEXT;
+
+//ANGLE_CONTEXT_handleΪANGLE_CONTEXTָ
+typedef ANGLE_CONTEXT*ANGLE_CONTEXT_handle;
+//ʼΪ=0
+#define ANGLE_CONTEXT_DEFAULTS {0,\
+	                            0,-SQRT3byTWO,SQRT3byTWO,\
+	                            1,-0.5,-0.5,\
+	                            0,1}
+void ANGLE_CONTEXT_CALC(ANGLE_CONTEXT_handle);
+void ANGLE_CONTEXT_EXPAND(ANGLE_CONTEXT_handle);
+void abc_dq0p_ctx(CLARKE_PARK_handle,ANGLE_CONTEXT_handle);
+void iabc_dq0p_ctx(CLARKE_PARK_handle,ANGLE_CONTEXT_handle);
+void abc_dq0n_ctx(CLARKE_PARK_handle,ANGLE_CONTEXT_handle);
+void iabc_dq0n_ctx(CLARKE_PARK_handle,ANGLE_CONTEXT_handle);
+
+//------------------------------------------λۼNCO
+//PhaseΪ32λλ(2^32Ӧ2)ۼȻƣƯƣ
+//Sine/Cosineɸ˷תÿһηֵ
+//ÿNCO_RESYNC_NUMİPhase¶һ
+#define NCO_PU_PER_RAD    683565275.6     /* 2^32/(2) */
+#define NCO_RAD_PER_PU    1.4629180793e-9 /* 2/2^32 */
+#define NCO_RESYNC_NUM    CTRL_ISR_TICKS(0.2)
+
+typedef struct {  Uint32 Phase;		//λ
+				  Uint32 Step;		//ÿλ
+				  float  W;			//룺Ƶrad/s
+				  float  Sine;
+				  float  Cosine;
+				  float  Angle;		//0~2еĽǶ
+				  Uint16 Count;		//¶
+		 	 	} NCO;
+
+//NCO_handleΪNCOָ
+typedef NCO*NCO_handle;
+#define NCO_DEFAULTS {0,0,0,0,1,0,0}
+void NCO_CALC(NCO_handle);
+void NCOZero(NCO_handle);
+
+//------------------------------------------ʱ
+//CMPAӰӼĴһĲЧټױְģԼ1.5ʱ
+//  Ƕȳǰ任æ+1.5wTOutѹʸ䵽ʵЧʱ̵λ
+//  Ԥ⣺һƵ1.5ĺi+1.5(i-i_last)˲в
+//λParamet[delay_comp]bit0 Ƕȳǰbit1 Ԥ⣻0Ϊأ任ֱæ
+#define DELAY_COMP_ANGLE   0x0001
+#define DELAY_COMP_PREDICT 0x0002
+#define DELAY_COMP_N       1.5//ʱ(ж)
+
+typedef struct {  float  W;			//룺Ƶrad/s
+				  Uint16 Mode;		//DELAY_COMP_ANGLE|DELAY_COMP_PREDICT
+				  ANGLE_CONTEXT Out;//任õĽǶ
+				  float  X[4];		///dqԤԭظд
+				  float  X_last[4];	//һĵķ(Ԥǰ)
+		 	 	} DELAY_COMP;
+
+//DELAY_COMP_handleΪDELAY_COMPָ
+typedef DELAY_COMP*DELAY_COMP_handle;
+#define DELAY_COMP_DEFAULTS {0,0,ANGLE_CONTEXT_DEFAULTS,{0,0,0,0},{0,0,0,0}}
+void DELAY_COMP_ANGLE_CALC(DELAY_COMP_handle,ANGLE_CONTEXT_handle);
+void DELAY_COMP_PREDICT_CALC(DELAY_COMP_handle);
+void DELAY_COMP_MODE(DELAY_COMP_handle,Uint16);
+void DelayCompZero(DELAY_COMP_handle);
+
+//------------------------------------------ϲ任
+//abcһClarkeõ£ͬһתdqdq
+typedef struct {  num_t  As;
+				  num_t  Bs;
+				  num_t  Cs;
+				  num_t  Alpha;
+				  num_t  Beta;
+				  num_t  Dsp;		//d
+				  num_t  Qsp;		//q
+				  num_t  Dsn;		//d
+				  num_t  Qsn;		//q
+				  num_t  V0;
+		 	 	} ABC_DQPN;
+
+//ABC_DQPN_handleΪABC_DQPNָ
+typedef ABC_DQPN*ABC_DQPN_handle;
+#define ABC_DQPN_DEFAULTS {0,0,0,0,0,0,0,0,0,0}
+void abc_dq0pn(ABC_DQPN_handle,ANGLE_CONTEXT_handle);
 //
 ////------------------------------------------pi
 //typedef struct {
@@ -91,17 +187,17 @@ void iabc_dq0n(CLARKE_PARK_handle);
 //	_iq   qOut;			//PI Output; 1.15 format
 //    }PI_CONTROL;
 typedef struct {
-    float   qdSum;        //Integrator sum; 1.31 format
-    float   currentError;
-    float   U;
-    float   qKp;          //Proportional Gain
-    float   qKi;          //Integral Gain
-    float   qKc;          //Anti-windup Gain
-    float   qOutMax;      //PI Output maximum limit
-    float   qOutMin;      //PI Output minimum limit
-    float   qInRef;       //οֵ
-    float   qInMeas;      //ֵ
-    float   qOut;         //PI Output; 1.15 format
+    num_t   qdSum;        //Integrator sum; 1.31 format
+    num_t   currentError;
+    num_t   U;
+    num_t   qKp;          //Proportional Gain
+    num_t   qKi;          //Integral Gain
+    num_t   qKc;          //Anti-windup Gain
+    num_t   qOutMax;      //PI Output maximum limit
+    num_t   qOutMin;      //PI Output minimum limit
+    num_t   qInRef;       //οֵ
+    num_t   qInMeas;      //ֵ
+    num_t   qOut;         //PI Output; 1.15 format
     }PI_CONTROL;
 
 //PI_CONTROL_handleΪPI_CONTROLָ
@@ -113,8 +209,28 @@ typedef PI_CONTROL*PI_CONTROL_handle;
 	                         }
 //void InitPI(PI_CONTROL_handle);
 void PI_CONTROL_CALC(PI_CONTROL_handle);
+//ޣÿѳ޷Ĳȫ˻ػ֣ٴڱͱ߽
+#define PI_KC_MAX 1.0
 extern void PIZero();//ⲿãΪ˱ļʹ
 
+////------------------------------------------PI
+//dqĸһ飬PI_BANK_COMMITд룬жд
+#define PI_BANK_NUM 4
+#define PI_DP 0//d
+#define PI_QP 1//q
+#define PI_DN 2//d
+#define PI_QN 3//q
+typedef struct {  PI_CONTROL Pi[PI_BANK_NUM];
+		 	 	} PI_BANK;
+
+//PI_BANK_handleΪPI_BANKָ
+typedef PI_BANK*PI_BANK_handle;
+#define PI_BANK_DEFAULTS {{PI_CONTROL_DEFAULTS,PI_CONTROL_DEFAULTS,PI_CONTROL_DEFAULTS,PI_CONTROL_DEFAULTS}}
+void PI_BANK_CALC(PI_BANK_handle);
+void PI_BANK_COMMIT(PI_BANK_handle,Uint16,Uint16,float,float,float,float);
+void PIBankZero(PI_BANK_handle);
+void PIGainCommit(void);
+
 ////------------------------------------------˲filtrate
 typedef struct {  float  X;
 				  float  X_last;
@@ -136,62 +252,110 @@ typedef struct {  float  X;
 //#define  b2    0.9823854506141253
 //FILTRATE_handleΪFILTRATEָ
 typedef FILTRATE*FILTRATE_handle;
-//#define FILTRATE_DEFAULTS_20Hz {0,0,0,0,0,0,0,\
-//	                       0.000039130205399144361,\
-//	                       0.000078260410798288723,\
-//	                       0.000039130205399144361,\
-//	                       -1.9822289297925286,\
-//	                       0.9823854506141253}//fs=10k
+/*#define FILTRATE_DEFAULTS_20Hz {0,0,0,0,0,0,0,\
+	                       0.000039130205399144361,\
+	                       0.000078260410798288723,\
+	                       0.000039130205399144361,\
+	                       -1.9822289297925286,\
+	                       0.9823854506141253}//fs=10k
+*/
+//20Hz׵ͨϵCTRL_FS(Ctrl_rate.h)
+#define LPF20Hz_A1   LPF2_A1(20)
+#define LPF20Hz_A2   LPF2_A2(20)
+#define LPF20Hz_A3   LPF2_A3(20)
+#define LPF20Hz_B1   LPF2_B1(20)
+#define LPF20Hz_B2   LPF2_B2(20)
 #define FILTRATE_DEFAULTS_20Hz {0,0,0,0,0,0,0,\
-		                   0.00015514842347569903,\
-		                   0.00031029684695139806,\
-		                   0.00015514842347569903,\
-		                   -1.964460580205232,\
-		                   0.96508117389913495}//fs=5k
+		                   LPF20Hz_A1,\
+		                   LPF20Hz_A2,\
+		                   LPF20Hz_A3,\
+		                   LPF20Hz_B1,\
+		                   LPF20Hz_B2}
 //void InitPI(FILTRATE_handle);
 void FILTRATE_CALC(FILTRATE_handle);
 
+////------------------------------------------˲
+//·һϵĶ˲תֱIIͣ״̬ţ
+//һѭͨ
+#define BIQUAD_BANK_NUM 12//3DDSRF_PLL4·
+
+typedef struct {  num_t  a1;//X
+				  num_t  a2;//X_last
+				  num_t  a3;//X_last1
+				  num_t  b1;//Y_last
+				  num_t  b2;//Y_last1
+		 	 	} BIQUAD_COEF;
+#define BIQUAD_COEF_20Hz {NUM_K(LPF20Hz_A1),NUM_K(LPF20Hz_A2),NUM_K(LPF20Hz_A3),NUM_K(LPF20Hz_B1),NUM_K(LPF20Hz_B2)}
+
+typedef struct {  num_t  X_in[BIQUAD_BANK_NUM];
+				  num_t  Y[BIQUAD_BANK_NUM];
+				  num_t  S1[BIQUAD_BANK_NUM];
+				  num_t  S2[BIQUAD_BANK_NUM];
+				  BIQUAD_COEF Coef;
+		 	 	} BIQUAD_BANK;
+
+//BIQUAD_BANK_handleΪBIQUAD_BANKָ
+typedef BIQUAD_BANK*BIQUAD_BANK_handle;
+#define BIQUAD_BANK_DEFAULTS_20Hz {{0},{0},{0},{0},BIQUAD_COEF_20Hz}
+void BIQUAD_BANK_CALC(BIQUAD_BANK_handle);
+
+//1DDSRF12·˲BIQUAD_BANK_CALC0ÿ·һFILTRATE_CALC(ԭ)
+//Ddsrf_bank0ֻΪڰPROF_DROOPԱߵ(ISR_PROFILẸ
+//Paramet[30+2*PROF_DROOP]ƽ[31+2*PROF_DROOP])ϵĶԱȼhost/bench_biquad.c
+#define DDSRF_BIQUAD_BANK 1
+#if !DDSRF_BIQUAD_BANK&&NUM_USE_IQ
+#error "DDSRF_BIQUAD_BANK=0 needs NUM_USE_IQ=0"
+#endif
+#define FILTRATE_DEFAULTS_20Hz_X4 FILTRATE_DEFAULTS_20Hz,FILTRATE_DEFAULTS_20Hz,\
+	                              FILTRATE_DEFAULTS_20Hz,FILTRATE_DEFAULTS_20Hz
+#define FILTRATE_BANK_DEFAULTS_20Hz {FILTRATE_DEFAULTS_20Hz_X4,FILTRATE_DEFAULTS_20Hz_X4,FILTRATE_DEFAULTS_20Hz_X4}
+#if !NUM_USE_IQ
+void FILTRATE_BANK_CALC(BIQUAD_BANK_handle,FILTRATE_handle);
+#endif
+
 //------------------------------------------
-typedef struct {  float  Ud;
-				  float  Uq;
-				  float  Udmean;
-				  float  Uqmean;
+typedef struct {  num_t  Ud;
+				  num_t  Uq;
+				  num_t  Udmean;
+				  num_t  Uqmean;
 				  float  Angle;
-				  float  Udout;
-				  float  Uqout;
+				  num_t  Udout;
+				  num_t  Uqout;
 		 	 	} JIEOU;
 
 //FILTRATE_handleΪFILTRATEָ
 typedef JIEOU*JIEOU_handle;
 #define JIEOU_DEFAULTS {0,0,0,0,0,0,0}
 //void InitPI(FILTRATE_handle);
-void JIEOU_CALC(JIEOU_handle);
+void JIEOU_CALC(JIEOU_handle,ANGLE_CONTEXT_handle);
 
 ////------------------------------------------DDSRF_PLLṹ
-typedef struct {  float  Udp;
-				  float  Uqp;
-				  float  Udn;
-				  float  Uqn;
-				  float  Udpmean;
-				  float  Uqpmean;
-				  float  Udnmean;
-				  float  Uqnmean;
+typedef struct {  num_t  Udp;
+				  num_t  Uqp;
+				  num_t  Udn;
+				  num_t  Uqn;
+				  num_t  Udpmean;
+				  num_t  Uqpmean;
+				  num_t  Udnmean;
+				  num_t  Uqnmean;
 				  float  Angle;
-				  float  Udpout;
-				  float  Uqpout;
-				  float  Udnout;
-				  float  Uqnout;
-				  FILTRATE Udp_filtrate;
-				  FILTRATE Uqp_filtrate;
-				  FILTRATE Udn_filtrate;
-				  FILTRATE Uqn_filtrate;
+				  num_t  Udpout;
+				  num_t  Uqpout;
+				  num_t  Udnout;
+				  num_t  Uqnout;
+				  Uint16 Ch;//˲еʼͨΪdpqpdnqn
 		 	 	} DDSRF_PLL;
 
 //FILTRATE_handleΪFILTRATEָ
 typedef DDSRF_PLL*DDSRF_PLL_handle;
-#define DDSRF_PLL_DEFAULTS {0,0,0,0,0,0,0,0,0,0,0,0,0,FILTRATE_DEFAULTS_20Hz,FILTRATE_DEFAULTS_20Hz,FILTRATE_DEFAULTS_20Hz,FILTRATE_DEFAULTS_20Hz}
+#define DDSRF_PLL_DEFAULTS(ch) {0,0,0,0,0,0,0,0,0,0,0,0,0,ch}
+#define I_DDSRF_CH  0
+#define U_DDSRF_CH  4
+#define Uo_DDSRF_CH 8
 //void InitPI(FILTRATE_handle);
-void DDSRF_PLL_CALC(DDSRF_PLL_handle);
+//ȶʵDDSRF_PLL_INһ˲飬DDSRF_PLL_OUT
+void DDSRF_PLL_IN(DDSRF_PLL_handle,BIQUAD_BANK_handle);
+void DDSRF_PLL_OUT(DDSRF_PLL_handle,BIQUAD_BANK_handle);
 
 
 
@@ -210,6 +374,10 @@ void predir_IFstart(void);
 void breaking(void);
 void droop(void);
 void neiwaihuan(void);
+void ThetaUpdate(void);
+void waihuan(void);
+void neihuan(void);
+void CurrentFeedback(void);
 void VectorControl_zero(void);
 void Initparameter(void);
 
@@ -1,10 +1,15 @@
 #ifndef __BSP__
 #define __BSP__
 
+#include "Ctrl_rate.h"
+#include "Adc_self.h"//HAL갴ADC_USE_DMAADC_DUALѡ񣬱ȿ
+
 interrupt void scirxintab_isr(void);
 interrupt void xint1_isr(void);
 interrupt void adca1_interrupt_isr(void);
+interrupt void epwm1_tz_isr(void);
 extern void ConfigureADC(void);
+extern void ConfigureAdcDual(void);
 //extern void InitSciGpio_a(void);
 extern void ConfigureEPwm(void);
 extern void ConfigureSci(void);
@@ -12,4 +17,49 @@ extern void InitSciParameter(void);
 extern void InitBoardGpio(void);
 extern void ConfigureXint(void);
 
+//------------------------------------------Ӳ
+//ƻ(жϡ)ֻ漸Ĵ
+//HOST_BUILDʱͨϵķдADCCMPA
+//ƴ뱾øġhost/hal_host.cﶨ壬host/Makefile
+#define HAL_ADC_NUM 16//Ĵ
+#ifndef HOST_BUILD
+#if ADC_USE_DMA
+#define HAL_ADC_FRAME_START() AdcFrameSwap()//ƹһ
+#define HAL_ADC_RESULT(n)   (Adc_dma_buf[Adc_frame.Ready][n])//DMAõ֡
+#define HAL_ADC_ISR_ACK()   {AdcFrameEnd();PieCtrlRegs.PIEACK.all=PIEACK_GROUP7;}
+#elif ADC_DUAL
+#define HAL_ADC_FRAME_START()
+#define HAL_ADC_RESULT(n)   ((n)<ADC2_RESULT_BASE?(&Adc1Result.ADCRESULT0)[n]:(&Adc2Result.ADCRESULT0)[(n)-ADC2_RESULT_BASE])
+#define HAL_ADC_ISR_ACK()   {Adc1Regs.ADCINTFLGCLR.bit.ADCINT1=1;PieCtrlRegs.PIEACK.all=PIEACK_GROUP1;}
+#else
+#define HAL_ADC_FRAME_START()
+#define HAL_ADC_RESULT(n)   ((&AdcResult.ADCRESULT0)[n])//nSOCĽ
+#define HAL_ADC_ISR_ACK()   {Adc1Regs.ADCINTFLGCLR.bit.ADCINT1=1;PieCtrlRegs.PIEACK.all=PIEACK_GROUP1;}
+#endif
+#define HAL_ADC_STAGE2_READY() (Adc1Regs.ADCINTFLG.bit.ADCINT2)//ˮߣһSOCת
+#define HAL_ADC_STAGE2_ACK()   {Adc1Regs.ADCINTFLGCLR.bit.ADCINT2=1;}
+#define HAL_PWM_CMPA(a,b,c) {EPwm1Regs.CMPA.half.CMPA=(a);EPwm2Regs.CMPA.half.CMPA=(b);EPwm3Regs.CMPA.half.CMPA=(c);}
+//ӱĲ(CTR=0˫ʱCTR=PRD)ڵTBCLKTBCLK=SYSCLKOUTCPUͬλ
+#if PWM_DOUBLE_UPDATE
+#define HAL_PWM_SINCE_SAMPLE() (EPwm1Regs.TBSTS.bit.CTRDIR?(Uint32)EPwm1Regs.TBCTR:(Uint32)EPwm1Regs.TBPRD-EPwm1Regs.TBCTR)
+#else
+#define HAL_PWM_SINCE_SAMPLE() (EPwm1Regs.TBSTS.bit.CTRDIR?(Uint32)EPwm1Regs.TBCTR:2*(Uint32)EPwm1Regs.TBPRD-EPwm1Regs.TBCTR)
+#endif
+#define HAL_TEST_PIN(v)     GpioDataRegs.GPADAT.bit.GPIO14=(v)//GPIO14ʾжʱ
+#define HAL_ADDR32(p)       ((Uint32)(p))//дDMAַĴ32λַ
+#else
+extern volatile Uint16 Hal_adc_result[HAL_ADC_NUM];
+extern volatile Uint16 Hal_cmpa[3];
+extern volatile Uint16 Hal_isr_ack;
+#define HAL_ADC_FRAME_START()//ûDMAHal_adc_result֡
+#define HAL_ADC_RESULT(n)   (Hal_adc_result[n])
+#define HAL_ADC_STAGE2_READY() 1//ʱ֡һд
+#define HAL_ADC_STAGE2_ACK()
+#define HAL_PWM_SINCE_SAMPLE() 0
+#define HAL_PWM_CMPA(a,b,c) {Hal_cmpa[0]=(a);Hal_cmpa[1]=(b);Hal_cmpa[2]=(c);}
+#define HAL_ADC_ISR_ACK()   {Hal_isr_ack++;}
+#define HAL_TEST_PIN(v)
+#define HAL_ADDR32(p)       ((Uint32)(uintptr_t)(p))//ָ64λֻȡ32λ
+#endif
+
 #endif
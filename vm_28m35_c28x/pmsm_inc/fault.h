@@ -8,6 +8,28 @@
 #ifndef FAULT_H_
 #define FAULT_H_
 
+//------------------------------------------Ӳ
+//ȽֱͬӽӲţ˽ڲ10λDAC(ͬADC1DAC=4ADC)
+//EPWM1~3ֱȽģ鴥TZ·ֱǿΪͣ
+//  COMP1ADC1A2(Ib)    DCAH  DCAEVT1һԷ
+//  COMP2ADC1A4(Ua)  ѹ  DCBH  DCBEVT1һԷ
+//  COMP3ADC1A6(Ub)  ѹ  DCAL  DCAEVT2ڷTZжתһԷ
+//ȽֻһͬˣֻеֻܣԿ
+//ADC_DUAL=1ʱIbUbĽADC2ıȽҪŰӸ
+#define PROT_I_TRIP   15.0//Ӳֵ(A)Լ18.7A
+#define PROT_U_TRIP   360.0//Ӳѹֵ(V)Լ375V
+#define PROT_ZERO_NOM 2048//У֮ǰеƫ(1.65V)ֵ
+#define PROT_QUALSEL  2//Ƚ3SYSCLKһ²㣬˵ؼ
+//ȽֱȽTRIPINţֲģȽӱ˶
+#define PROT_TRIPIN_COMP1 DC_TRIPIN7
+#define PROT_TRIPIN_COMP2 DC_TRIPIN8
+#define PROT_TRIPIN_COMP3 DC_TRIPIN9
+
+extern void ConfigureProtect(void);
+extern void ProtectThreshold(void);
+extern void ProtectReset(void);
+extern void HardwareFaultLatch(void);
+
 //ϱ
 extern void FastFaultTest(void);
 extern void CurrentOverFault(void);
@@ -25,7 +25,8 @@ struct  FLAGFAULT_BITS {
         Uint16 hightemcircuit:1;   /*·¶ȹ*/
         Uint16 hightemmotor:1;     /*¶ȹ*/
         Uint16 ocfault:1;          /*Ӳ*/
-        Uint16 rsvd2:8;
+        Uint16 hwovervoltage:1;    //Ӳѹ(Ƚ)
+        Uint16 rsvd2:7;
 
 };
 //
@@ -42,7 +43,8 @@ struct  FLAGSYSTEM_BITS {
         Uint16 if_start:1;//ԤλģʽеĶλ01־
         Uint16 pre_dir_sign:1;
         Uint16 mars_sign:1;
-        Uint16 rsvd1:6;
+        Uint16 pwmon:1;//PWMѴ򿪣ڼ̨У
+        Uint16 rsvd1:5;
 };
 //
 
@@ -91,7 +93,7 @@ extern  struct ADCDEALRES_REGS AdcdealRegs;
 //-------------------------------λ-----------------------------------//
 struct  COUNT_BITS {
 
-        Uint16 ADC_ZeroCNTloop:4;     //ѭ
+        Uint16 rsvd0:4;
         Uint16 rsvd1:4;
         Uint16 rsvd2:1;
         Uint16 rsvd3:7;
@@ -6,12 +6,20 @@
 #include <stdint.h>
 #include <stdlib.h>
 //#include "IQmathLib.h"
+#include "Ctrl_rate.h"
 #include "Adc_self.h"
 #include "flag.h"
 #include"fault.h"
+#include "Trig_table.h"
+#include "Num_type.h"
 #include "Vector_control.h"
 #include "Switch.h"
+#include "Modulator.h"
+#include "Profile.h"
 #include "message.h"
+#include "Ipc_ring.h"
+#include "Tlm_mirror.h"
+#include "Param_sync.h"
 
 //Ƕһ#define   һextern float
 //SCI
@@ -107,6 +115,8 @@
 #define slope_delt_t 83
 #define Slope_en_sign 84
 #define current_ref_limit 85
+#define delay_comp 86//ʱbit0 Ƕȳǰbit1 Ԥ
+#define tlm_decim 87//вճȡ(жϴ)0ĬTLM_DECIM
 #define rs_psm 102
 #define Ld_psm 103
 #define Lq_psm 104
@@ -133,11 +143,12 @@
 #define pibytwo (PI/2)//25736
 #define c2 1430  //286  //12000//7000  //4685824//286//10du
 
-#define vn_comp  3500  //򲹳ʱ
+#define vn_comp  CTRL_TICKS(0.7)  //򲹳ʱ
 
 
 
 extern unsigned int Switchsystem;
+extern unsigned int Switchrearm;
 extern unsigned int RCBUF[24];//RS485 ջ ϵͳͨѶЭ25ݣ
 extern unsigned int ReciveRCOUNT;//RS485 ռ 0~25
 extern unsigned int RC_DataCount;   //ݼ
@@ -167,12 +178,8 @@ extern unsigned int SendDataNumber;     //
 extern unsigned int PSO_datainit_flag;
 extern float Paramet[ParameterNumber];
 
-extern Uint32 AC_Zero[12][8];
 extern Uint32 AC_ZeroMean[12];
-extern Uint16 AC_Zero_yu[12][8];
-extern Uint16 AC_Zero_yuz[12];
 extern Uint16 ADCresult[12] ;    //2
-extern Uint16 ADCZeroCNT0;      //6У600
 extern int32 ADCresultNEW[12]; //ڴȥƫ֮ݣѡ򲻼ֱƫã
 extern Uint16 adcresult15;
 extern Uint32 ADCcount;
@@ -184,7 +191,6 @@ extern Uint16 N_stage;
 extern Uint16 N_stage2;
 extern Uint16 N_stage1;
 //־
-extern Uint32 n_coop;
 extern unsigned int nSerialNumber;
 
 
@@ -207,21 +213,15 @@ extern float max_current;
 extern float min_current;
 
 
-extern PI_CONTROL PI_Ud;
-extern PI_CONTROL PI_Uq;
-extern PI_CONTROL PI_Id;
-extern PI_CONTROL PI_Iq;
-extern PI_CONTROL PI_Udn;
-extern PI_CONTROL PI_Uqn;
-extern PI_CONTROL PI_Idn;
-extern PI_CONTROL PI_Iqn;
+extern PI_BANK PI_voltage;//ѹ⻷dq
+extern PI_BANK PI_current;//ڻdq
 extern PI_CONTROL PI_PCC;
 
 //任
-extern ABC_PARK I_conversion;//Iabcii
-extern ABC_PARK U_conversion;//ii±idiq
+extern ABC_DQPN I_conversion;//Iabcii
+extern ABC_DQPN U_conversion;//ii±idiq
 //extern ABC_PARK Io_conversion;//uu±uduq
-extern ABC_PARK Uo_conversion;//uduquu
+extern ABC_DQPN Uo_conversion;//uduquu
 extern ABC_PARK Uref_conversion; //ѹ
 extern ABC_PARK Uout_conversion;
 extern ABC_PARK Uoutn_conversion;
@@ -241,6 +241,10 @@ extern JIEOU jieou_negative;
 extern DDSRF_PLL I_DDSRF_PLL;
 extern DDSRF_PLL U_DDSRF_PLL;
 extern DDSRF_PLL Uo_DDSRF_PLL;
+extern BIQUAD_BANK Ddsrf_bank;//DDSRF_PLLõ12·˲
+#if !DDSRF_BIQUAD_BANK
+extern FILTRATE Ddsrf_filtrate[BIQUAD_BANK_NUM];//DDSRF_BIQUAD_BANK=0ʱ12·FILTRATE
+#endif
 
 extern float a_graph[graphNumber];
 extern float b_graph[graphNumber];
@@ -303,6 +307,13 @@ extern float Uoqpout;
 extern float Uodnout;
 extern float Uoqnout;
 
+//ʱΪDDSRF˫ʱΪδ˲ĵ
+extern float Idpfb;
+extern float Iqpfb;
+extern float Idnfb;
+extern float Iqnfb;
+extern Uint16 Ctrl_slow;//˫£1ʾж
+
 //---------------------------㲻ƽ
 extern float VUFout;
 extern float VUFpcc;
@@ -328,6 +339,9 @@ extern float delt_Id;
 extern float delt_Iq;
 
 extern float theta_fan;                                                                                 //Ƕȡ任
+extern ANGLE_CONTEXT Theta_context;//theta_fanӦĽǶ
+extern NCO Theta_nco;//theta_fanλۼ
+extern DELAY_COMP Delay_comp;//任õĳǰǶȡԤ
 
                                                                                     //Ƕʾ
 
@@ -399,38 +413,16 @@ extern float PSO_g[4];
 //*****************************************************************************
 // IPC
 //*****************************************************************************
-#define C28_CTOM_PASSMSG  0x0003FBF4            // Used by C28 to pass address
-                                                // of local variables to perform
-                                                // actions on
-#define C28_MTOC_PASSMSG  0x0003FFF4            // Used by M3 to pass address of
-                                                // local variables to perform
-                                                // actions on
-
 #define C28_S0SARAM_START 0xC000                // Start of S0 SARAM in C28
                                                 // memory map
 #define C28_S1SARAM_START 0xD000                // Start of S1 SARAM in C28
                                                 // memory map
-#define usMBuffer_SIZE 100
-//*****************************************************************************
-// At least 1 volatile global tIpcController instance is required when using
-// IPC API Drivers.
-//*****************************************************************************
-extern volatile tIpcController g_sIpcController1;
-extern volatile tIpcController g_sIpcController2;
-
 //*****************************************************************************
 // Global variable used in this example to track errors
 //*****************************************************************************
 extern volatile Uint16 ErrorFlag;
-extern volatile Uint16 wErrorFlag;
-extern volatile unsigned short ErrorCount;
-extern volatile unsigned short wErrorCount;
-//*****************************************************************************
-// Global variables used in this example to read/write data passed between
-// M3 and C28
-//*****************************************************************************
-extern Uint16 usMBuffer[usMBuffer_SIZE];
-extern Uint16 usCBuffer[usMBuffer_SIZE];
-extern Uint16 ipc_to_pso_flag;
-extern unsigned int IPC_get_flag;
+//fastcodeεװ/еַļ
+extern Uint16 FastcodeLoadStart;
+extern Uint16 FastcodeLoadSize;
+extern Uint16 FastcodeRunStart;
 #endif
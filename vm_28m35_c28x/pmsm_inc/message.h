@@ -50,8 +50,8 @@ extern void PSOsend(float U[10]);
 // Function Prototypes
 //*****************************************************************************
 __interrupt void MtoCIPC1IntHandler(void);
-__interrupt void MtoCIPC2IntHandler(void);
 void Error (void);
 void IPCdata_tran(void);
+void CtrlBackground(void);
 
 #endif
@@ -5,28 +5,165 @@
 
 #include "DSP28x_Project.h"
 
+#pragma CODE_SECTION(Adcread,"fastcode");
+#pragma CODE_SECTION(Adcdeal,"fastcode");
+#pragma CODE_SECTION(AdcZeroSample,"fastcode");
+#pragma CODE_SECTION(AdcreadI,"fastcode");
+#pragma CODE_SECTION(AdcreadU,"fastcode");
+#pragma CODE_SECTION(AdcdealI,"fastcode");
+#pragma CODE_SECTION(AdcdealU,"fastcode");
+
+#if ADC_USE_DMA
+#pragma CODE_SECTION(AdcFrameSwap,"fastcode");
+#pragma CODE_SECTION(AdcFrameEnd,"fastcode");
+#pragma DATA_SECTION(Adc_dma_buf,"DMARAML2");//DMAֻܷL2/L3
+
+Uint16 Adc_dma_buf[2][ADC_FRAME_NUM];
+ADC_FRAME Adc_frame=ADC_FRAME_DEFAULTS;
+
+//жڣдĻ彻ãһ֡дһ
+//ģʽDMAÿδ俪ʼʱӰӼĴװصַӰӾ
+void AdcFrameSwap(void)
+{
+    Adc_frame.Ready=DmaRegs.CH1.DST_BEG_ADDR_SHADOW==HAL_ADDR32(&Adc_dma_buf[1][0]);
+    EALLOW;
+    DmaRegs.CH1.DST_BEG_ADDR_SHADOW=HAL_ADDR32(&Adc_dma_buf[Adc_frame.Ready^1][0]);
+    DmaRegs.CH1.DST_ADDR_SHADOW=HAL_ADDR32(&Adc_dma_buf[Adc_frame.Ready^1][0]);
+    EDIS;
+}
+
+//жϳڣͳ֡ͳʱ
+void AdcFrameEnd(void)
+{
+    Adc_frame.Frame++;
+    if(PieCtrlRegs.PIEIFR7.bit.INTx1)//֡û꣬һ֡Ѿ
+        Adc_frame.Late++;
+    if(DmaRegs.CH1.CONTROL.bit.OVRFLG)
+    {
+        Adc_frame.DmaOvr++;
+        EALLOW;
+        DmaRegs.CH1.CONTROL.bit.ERRCLR=1;
+        EDIS;
+    }
+}
+#endif
+
+#if ADC_PIPELINE
+#pragma CODE_SECTION(AdcVoltageStage,"fastcode");
+
+ADC_PIPE Adc_pipe=ADC_PIPE_DEFAULTS;
+#endif
+
+ADC_ZERO Adc_zero=ADC_ZERO_DEFAULTS;
+
+//жУۼӣPWMʱۼӣֻмӷ
+static void AdcZeroSample(void)
+{
+    Uint16 i;
+
+    if(FlagRegs.flagsystem.bit.pwmon)//вУ㣬
+    {
+        for(i=0;i<12;i++)
+            Adc_zero.Sum[i]=0;
+        Adc_zero.Cnt=0;
+        Adc_zero.Skip=1;
+        return;
+    }
+    for(i=0;i<12;i++)
+        Adc_zero.Sum[i]+=ADCresult[i];
+    if(++Adc_zero.Cnt<ADC_ZERO_BLOCK)
+        return;
+
+    if(Adc_zero.Skip)
+        Adc_zero.Skip=0;
+    else if(Adc_zero.BlockReady)
+        Adc_zero.Drop++;
+    else
+    {
+        for(i=0;i<12;i++)
+            Adc_zero.Block[i]=Adc_zero.Sum[i];
+        Adc_zero.BlockReady=1;
+    }
+    for(i=0;i<12;i++)
+        Adc_zero.Sum[i]=0;
+    Adc_zero.Cnt=0;
+}
+
+//̨У㣺ֵָƽжϷ
+void AdcZeroUpdate(void)
+{
+    Uint16 i;
+    Uint32 mean;
+
+    if(Adc_zero.BlockReady==0||Adc_zero.Publish)
+        return;
+    for(i=0;i<12;i++)
+    {
+        mean=(Adc_zero.Block[i]<<ADC_ZERO_FRAC)/ADC_ZERO_BLOCK;
+        if(Adc_zero.Blocks==0)//һֱֵһ
+            Adc_zero.Mean[i]=mean;
+        else
+            Adc_zero.Mean[i]=Adc_zero.Mean[i]+((int32)(mean-Adc_zero.Mean[i])>>ADC_ZERO_SHIFT);
+        Adc_zero.Next[i]=(Adc_zero.Mean[i]+(1<<(ADC_ZERO_FRAC-1)))>>ADC_ZERO_FRAC;
+    }
+    Adc_zero.BlockReady=0;
+    if(Adc_zero.Blocks<0xFFFF)
+        Adc_zero.Blocks++;
+    Adc_zero.Publish=1;
+}
+
+//·
+static void AdcreadI(void)
+{
+	   ADCresult[0]=HAL_ADC_RESULT(ADC_SLOT_IA);//Ia
+	   ADCresult[1]=HAL_ADC_RESULT(ADC_SLOT_IB);//Ib
+	   ADCresult[2]=HAL_ADC_RESULT(ADC_SLOT_IC);//Ic
+}
 
+//ѹPCC
+static void AdcreadU(void)
+{
+	   ADCresult[3]=HAL_ADC_RESULT(ADC_SLOT_UA);//Ua
+	   ADCresult[4]=HAL_ADC_RESULT(ADC_SLOT_UB);//Ub
+	   ADCresult[5]=HAL_ADC_RESULT(ADC_SLOT_UC);//Uc
+	   ADCresult[6]=HAL_ADC_RESULT(ADC_SLOT_IOA);//Ioa
+	   ADCresult[7]=HAL_ADC_RESULT(ADC_SLOT_IOB);//Iob
+	   ADCresult[8]=HAL_ADC_RESULT(ADC_SLOT_IOC);//Iob
+	   ADCresult[9]=HAL_ADC_RESULT(ADC_SLOT_UOA);//Uoa
+	   //UobUocûתADC_FRAME_NUM
+}
+
+//ˮʱֻѹAdcVoltageStage
 void  Adcread()
 {
-	   ADCresult[0]=AdcResult.ADCRESULT0;//Ia
-	   ADCresult[1]=AdcResult.ADCRESULT1;//Ib
-	   ADCresult[2]=AdcResult.ADCRESULT2;//Ic
-	   ADCresult[3]=AdcResult.ADCRESULT3;//Ua
-	   ADCresult[4]=AdcResult.ADCRESULT4;//Ub
-	   ADCresult[5]=AdcResult.ADCRESULT5;//Uc
-	   ADCresult[6]=AdcResult.ADCRESULT6;//Ioa
-	   ADCresult[7]=AdcResult.ADCRESULT7;//Iob
-	   ADCresult[8]=AdcResult.ADCRESULT8;//Iob
-	   ADCresult[9]=AdcResult.ADCRESULT9;//Uoa
-	   ADCresult[10]=AdcResult.ADCRESULT10;//Uob
-	   //ADCresult[11]=AdcResult.ADCRESULT11;//Uoc
+	   HAL_ADC_FRAME_START();
+#if ADC_PIPELINE
+	   if(Adc_pipe.Stale)//һ֡ADCINT2ʱλ֡ûתĵѹɺõ
+	   {
+	       HAL_ADC_STAGE2_ACK();
+	       Adc_pipe.Stale=0;
+	   }
+#endif
+	   AdcreadI();
+#if !ADC_PIPELINE
+	   AdcreadU();
+#endif
 }
 
 //adcݴ
 
-void  Adcdeal()
+//ƫ÷͵·
+static void AdcdealI(void)
 {
 	 //ADļ㼰У
+    if(Adc_zero.Publish&&FlagRegs.flagsystem.bit.pwmon==0)//̨õƫãڼ黻
+    {
+        Uint16 i;
+        for(i=0;i<12;i++)
+            AC_ZeroMean[i]=Adc_zero.Next[i];
+        Adc_zero.Publish=0;
+        FlagRegs.flagsystem.bit.AC0CheckFinished=1;
+    }
     if(FlagRegs.flagsystem.bit.AC0CheckFinished==1)  //1ҲﵽҪֵ
     {
         //Udc=ADCresultNEW[1]*26532/10;
@@ -46,7 +183,14 @@ void  Adcdeal()
        //еIc
     	   ADCresultNEW[2]= ADCresult[2]-AC_ZeroMean[2];//ע⣺·ǰҪƫﵽAC_ZeroMean[1]
     	   Adcget.Ic=ADCresultNEW[2]*ADC_I;
+    }
+}
 
+//ѹPCC֡ۼУ
+static void AdcdealU(void)
+{
+    if(FlagRegs.flagsystem.bit.AC0CheckFinished==1)
+    {
        //ݵѹUa
     	   ADCresultNEW[3]= ADCresult[3]- AC_ZeroMean[3];//
     	   Adcget.Ua=ADCresultNEW[3]*ADC_U;
@@ -85,55 +229,47 @@ void  Adcdeal()
 
 
     }
-    else
-    {
-
-       Uint16 i;
-       Uint16 j;
 
+    AdcZeroSample();
+}
 
-       ADCZeroCNT0 +=1;
-       for(i=0;i<12;i++)//12
-        {
-    	  AC_Zero[i][CounterRegs.count.bit.ADC_ZeroCNTloop] += ADCresult[i];
-    	}
-       if(  ADCZeroCNT0 == ADCZeroCNT0num )//600ѭ
-    	{
-    		ADCZeroCNT0 = 0;
-    	    for(i=0;i<12;i++)
-    		{
-    	     //ȡ
-    		AC_Zero_yu[i][CounterRegs.count.bit.ADC_ZeroCNTloop] = AC_Zero[i][CounterRegs.count.bit.ADC_ZeroCNTloop] % ADCZeroCNT0num;
-    		//
-    		AC_Zero[i][CounterRegs.count.bit.ADC_ZeroCNTloop] = AC_Zero[i][CounterRegs.count.bit.ADC_ZeroCNTloop]/ ADCZeroCNT0num;
-    		}
-    		CounterRegs.count.bit.ADC_ZeroCNTloop += 1;
-    	}
-
-      if(CounterRegs.count.bit.ADC_ZeroCNTloop == ADCZeroCNTloopnum )	//8ѭһѭ200
-       {
-            for(i=0;i<12;i++)
-    	   {
-            for(j=0;j<ADCZeroCNTloopnum ;j++)
-    		{
-              AC_Zero_yuz[i] =AC_Zero_yuz[i] + AC_Zero_yu[i][j];//ۼ
-    		  AC_ZeroMean[i] = AC_ZeroMean[i] + AC_Zero[i][j] ;//ۼ
-    		}
-            AC_Zero_yuz[i] = AC_Zero_yuz[i]/ADCZeroCNT0num;
-    		AC_ZeroMean[i] = (AC_ZeroMean[i]+AC_Zero_yuz[i])/ADCZeroCNTloopnum ;
-    	}
-
-     FlagRegs.flagsystem.bit.AC0CheckFinished = 1;
-     CounterRegs.count.bit.ADC_ZeroCNTloop = 0;
-       }
-    //ʾ
-     // Paramet[pianzhi_U_run]= AC_ZeroMean[0];
-     //Paramet[pianzhi_W_run]= AC_ZeroMean[1];
+//ˮʱֻѹAdcVoltageStage
+void  Adcdeal()
+{
+    AdcdealI();
+#if ADC_PIPELINE
+    Adc_pipe.Done=0;
+#else
+    AdcdealU();
+#endif
+}
 
+#if ADC_PIPELINE
+//ڶΣһSOCת꣬ѹ㣻һֻ֡һΣжϳٵһζ
+void AdcVoltageStage(void)
+{
+    Uint16 n=0;
 
+    if(Adc_pipe.Done)
+        return;
+    Adc_pipe.Done=1;
+    while(HAL_ADC_STAGE2_READY()==0)
+    {
+        if(++n>=ADC_PIPE_SPIN_MAX)
+        {
+            Adc_pipe.Timeout++;
+            Adc_pipe.Stale=1;
+            return;
+        }
     }
-
+    HAL_ADC_STAGE2_ACK();
+    Adc_pipe.Spin=n;
+    if(n>Adc_pipe.SpinMax)
+        Adc_pipe.SpinMax=n;
+    AdcreadU();
+    AdcdealU();
 }
+#endif
 
 void ADCzero()
 {
@@ -152,35 +288,17 @@ void ADCzero()
 	     Adcget.Uoc=0;
 
 
-	     CounterRegs.count.bit.ADC_ZeroCNTloop = 0;//Уxѭ
-	     ADCZeroCNT0=0;//У
-	     int i , j ;
-         for(i=0;i<12;i++)
-        {
-        	 ADCresultNEW[0]=0;
-        	 ADCresultNEW[1]=0;
-        	 ADCresultNEW[2]=0;
-             ADCresultNEW[3]=0;
-             ADCresultNEW[4]=0;
-        	 ADCresultNEW[5]=0;
-        	 ADCresultNEW[6]=0;
-        	 ADCresultNEW[7]=0;
-        	 ADCresultNEW[8]=0;
-        	 ADCresultNEW[9]=0;
-        	 ADCresultNEW[10]=0;
-        	 ADCresultNEW[11]=0;
-
-		        for(j=0;j<8;j++)
-		       {
-				      AC_Zero[i][j] = 0 ;
-				      AC_Zero_yu[i][j] = 0 ;
-		       }
-        }
+	     int i ;
          for(i=0;i<12;i++)
 	    {
+		       ADCresultNEW[i]=0;
 		       AC_ZeroMean[i]=0;
-		       AC_Zero_yuz[i]= 0 ;
+		       Adc_zero.Sum[i]=0;
+		       Adc_zero.Mean[i]=0;
 	    }
-
+         Adc_zero.Cnt=0;
+         Adc_zero.BlockReady=0;
+         Adc_zero.Publish=0;
+         Adc_zero.Skip=0;
+         Adc_zero.Blocks=0;
 }
-
@@ -0,0 +1,119 @@
+/*
+ * Modulator.c
+ *   ƣע롢ơռձȡ
+ */
+
+#include "DSP28x_Project.h"
+
+#pragma CODE_SECTION(MODULATOR_CALC,"fastcode");
+#pragma CODE_SECTION(DeadTimeComp,"fastcode");
+
+//CMPA*fΪ˲
+static float DeadTimeComp(float i,float *f)
+{
+	float k;
+	float d=(i-*f)*MOD_DT_KF;
+
+	*f+=d;
+	k=(*f+d*MOD_DT_LEAD)*(1.0/MOD_DT_IBAND);
+	if(k>1) k=1;
+	if(k<-1) k=-1;
+	return k*MOD_DT_CMP;
+}
+
+void MODULATOR_CALC(MODULATOR_handle p)
+{
+	float ma=p->Ua*p->Kdc;
+	float mb=p->Ub*p->Kdc;
+	float mc=p->Uc*p->Kdc;
+	float vmax,vmin,span,s;
+	float ca,cb,cc;
+
+	vmax=ma;
+	vmin=ma;
+	if(mb>vmax) vmax=mb;
+	if(mb<vmin) vmin=mb;
+	if(mc>vmax) vmax=mc;
+	if(mc<vmin) vmin=mc;
+
+	if(p->Mode==MOD_MINMAX)
+	{
+		//עԳƷֲ[-span/2,span/2]span=2*Mmax
+		p->V0=-0.5*(vmax+vmin);
+		span=vmax-vmin;
+		if(span>2*p->Mmax)
+		{
+			p->Overmod++;
+			//ߵѹֻspanȱСŲıߵѹλ
+			//޷ʱѰСԳƷźãֱ
+			if(p->Ovm==MOD_OVM_SCALE)
+			{
+				s=2*p->Mmax/span;
+				ma*=s;mb*=s;mc*=s;
+				p->V0*=s;
+			}
+		}
+		ma+=p->V0;
+		mb+=p->V0;
+		mc+=p->V0;
+	}
+	else
+	{
+		p->V0=0;
+		if(vmax>p->Mmax||vmin<-p->Mmax)
+		{
+			p->Overmod++;
+			if(p->Ovm==MOD_OVM_SCALE)
+			{
+				s=(vmax>-vmin)?vmax:-vmin;
+				s=p->Mmax/s;
+				ma*=s;mb*=s;mc*=s;
+			}
+		}
+	}
+
+	//MOD_OVM_CLAMPԼź
+	if(ma>p->Mmax) ma=p->Mmax;
+	if(ma<-p->Mmax) ma=-p->Mmax;
+	if(mb>p->Mmax) mb=p->Mmax;
+	if(mb<-p->Mmax) mb=-p->Mmax;
+	if(mc>p->Mmax) mc=p->Mmax;
+	if(mc<-p->Mmax) mc=-p->Mmax;
+	p->Ma=ma;
+	p->Mb=mb;
+	p->Mc=mc;
+
+	//CTR>CMPAʱϹܿͨռձ(1+m)/2
+	ca=(MOD_PWM_PRD/2)*(1-ma);
+	cb=(MOD_PWM_PRD/2)*(1-mb);
+	cc=(MOD_PWM_PRD/2)*(1-mc);
+	if(p->Dtc)
+	{
+		ca-=DeadTimeComp(p->Ia,&p->Ifa);
+		cb-=DeadTimeComp(p->Ib,&p->Ifb);
+		cc-=DeadTimeComp(p->Ic,&p->Ifc);
+		if(ca<0) ca=0;
+		if(ca>MOD_PWM_PRD) ca=MOD_PWM_PRD;
+		if(cb<0) cb=0;
+		if(cb>MOD_PWM_PRD) cb=MOD_PWM_PRD;
+		if(cc<0) cc=0;
+		if(cc>MOD_PWM_PRD) cc=MOD_PWM_PRD;
+	}
+	p->Cmpa=ca;
+	p->Cmpb=cb;
+	p->Cmpc=cc;
+}
+
+//λParamet[modulation]bit0 0 SPWM/1 MINMAXbit1 0 ޷/1 ȱbit2 1 
+void MODULATOR_MODE(MODULATOR_handle p,Uint16 sel)
+{
+	p->Mode=(sel&1)?MOD_MINMAX:MOD_SPWM;
+	p->Ovm=(sel&2)?MOD_OVM_SCALE:MOD_OVM_CLAMP;
+	if((sel&4)&&p->Dtc==0)//մʱ˲ֵ
+	{
+		p->Ifa=0;
+		p->Ifb=0;
+		p->Ifc=0;
+	}
+	p->Dtc=(sel&4)?1:0;
+}
@@ -0,0 +1,39 @@
+/*
+ * Param_sync.c
+ *   ͬնˣ˵Param_sync.h
+ */
+
+#include "DSP28x_Project.h"
+
+PARAM_SYNC Param_sync=PARAM_SYNC_DEFAULTS;
+
+//һ¼ÿǸĿֵŶдҪһȫм䶪
+void ParamSyncApply(const IPC_REC *r)
+{
+    union FLOAT_IPCF v;
+
+    if(r->Seq!=Param_sync.Seq)
+    {
+        Param_sync.Gap++;
+        Param_sync.Need=1;
+    }
+    Param_sync.Seq=r->Seq+1;
+    if(r->Arg<ParameterNumber)
+    {
+        v.bit.MEM1=r->D0;
+        v.bit.MEM2=r->D1;
+        Paramet[r->Arg]=v.all;
+    }
+    Param_sync.Rx++;
+}
+
+//ѭãҪȫʱIPC_REC_SYNCM3ûһȦٷ
+void ParamSyncPoll(void)
+{
+    if(Param_sync.Need&&IpcRingFree())
+    {
+        IpcRingPush(IPC_REC_SYNC,0,0,0,0);
+        IPC_RING_DOORBELL();
+        Param_sync.Need=0;
+    }
+}
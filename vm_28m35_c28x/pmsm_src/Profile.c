@@ -0,0 +1,135 @@
+/*
+ * Profile.c
+ *   жϷֶμʱͳС//ƽֱͼ
+ *   ÿεʱ京һProfileMarkĿ(ʮ)
+ */
+
+#include "DSP28x_Project.h"
+
+#ifdef ISR_PROFILE
+
+#pragma CODE_SECTION(ProfileMark,"fastcode");
+#pragma CODE_SECTION(ProfileLatency,"fastcode");
+#pragma CODE_SECTION(ProfileEnd,"fastcode");
+#pragma DATA_SECTION(Isr_prof,"fastdata");
+
+ISR_PROF Isr_prof;
+
+static void ProfileStageClear(PROF_STAGE *p)
+{
+    Uint16 j;
+    p->Min=0xFFFFFFFF;
+    p->Max=0;
+    p->Sum=0;
+    p->N=0;
+    p->Mean=0;
+    for(j=0;j<PROF_HIST_NUM;j++)
+        p->Hist[j]=0;
+}
+
+//һһεͳ
+static void ProfileStageAdd(PROF_STAGE *p,Uint32 dt)
+{
+    Uint16 bin;
+
+    if(dt<p->Min)
+        p->Min=dt;
+    if(dt>p->Max)
+        p->Max=dt;
+    p->Sum+=dt;
+    p->N++;
+    bin=(dt>>PROF_HIST_SHIFT)<PROF_HIST_NUM?(Uint16)(dt>>PROF_HIST_SHIFT):PROF_HIST_NUM-1;
+    if(p->Hist[bin]<0xFFFF)
+        p->Hist[bin]++;
+}
+
+//ڽʵƽһûִйĶμ0
+static void ProfileStageMean(PROF_STAGE *p)
+{
+    p->Mean=p->N?(float)p->Sum/p->N:0;
+    p->Sum=0;
+    p->N=0;
+}
+
+static void ProfileClear(void)
+{
+    Uint16 i;
+    for(i=0;i<PROF_STAGE_NUM;i++)
+        ProfileStageClear(&Isr_prof.Stage[i]);
+    ProfileStageClear(&Isr_prof.Latency);
+    Isr_prof.TotalMax=0;
+    Isr_prof.Count=0;
+    Isr_prof.Clear=0;
+}
+
+//ʱ1Уȡ󣬲ж
+void ProfileInit(void)
+{
+    EALLOW;
+    CpuTimer1Regs.TCR.bit.TSS=1;
+    CpuTimer1Regs.PRD.all=0xFFFFFFFF;
+    CpuTimer1Regs.TPR.all=0;
+    CpuTimer1Regs.TPRH.all=0;
+    CpuTimer1Regs.TCR.bit.TIE=0;
+    CpuTimer1Regs.TCR.bit.TRB=1;
+    CpuTimer1Regs.TCR.bit.TSS=0;
+    EDIS;
+    ProfileClear();
+}
+
+//¼һֶε㵽ڵ㵽s
+void ProfileMark(Uint16 s)
+{
+    Uint32 now,dt;
+
+    now=CpuTimer1Regs.TIM.all;
+    dt=Isr_prof.Mark-now;//¼޷żԴ
+    Isr_prof.Mark=now;
+    ProfileStageAdd(&Isr_prof.Stage[s],dt);
+}
+
+//дCMPAãӲ㵽ڵʱֱӶPWMýжʱĶʱֵ
+void ProfileLatency(void)
+{
+    ProfileStageAdd(&Isr_prof.Latency,HAL_PWM_SINCE_SAMPLE());
+}
+
+//жϳڣжϵֵƽ
+void ProfileEnd(void)
+{
+    Uint16 i;
+    Uint32 dt;
+
+    if(Isr_prof.Clear)
+    {
+        ProfileClear();
+        return;
+    }
+    dt=Isr_prof.Entry-CpuTimer1Regs.TIM.all;
+    if(dt>Isr_prof.TotalMax)
+        Isr_prof.TotalMax=dt;
+
+    Isr_prof.Count++;
+    if(Isr_prof.Count>=PROF_WINDOW)
+    {
+        for(i=0;i<PROF_STAGE_NUM;i++)
+            ProfileStageMean(&Isr_prof.Stage[i]);
+        ProfileStageMean(&Isr_prof.Latency);
+        Isr_prof.Count=0;
+    }
+}
+
+//ѭãƽusдParametMinHist[]ֻڷ￴Profile.h
+void ProfilePublish(void)
+{
+    Uint16 i;
+    for(i=0;i<PROF_STAGE_NUM;i++)
+    {
+        Paramet[PROF_PARAMET_BASE+2*i]=Isr_prof.Stage[i].Mean*PROF_US_PER_CYCLE;
+        Paramet[PROF_PARAMET_BASE+2*i+1]=Isr_prof.Stage[i].Max*PROF_US_PER_CYCLE;
+    }
+    Paramet[PROF_PARAMET_TOTAL]=Isr_prof.TotalMax*PROF_US_PER_CYCLE;
+    Paramet[PROF_PARAMET_LATENCY]=Isr_prof.Latency.Max*PROF_US_PER_CYCLE;
+}
+
+#endif
@@ -20,6 +20,7 @@ void PWMoff(void)
     //ePWM3
     EPwm3Regs.AQSFRC.bit.RLDCSF = 3 ;//ѡֱӼ
     EPwm3Regs.DBCTL.bit.OUT_MODE=0;
+    FlagRegs.flagsystem.bit.pwmon=0;
 //    //ePWM7
 //    EPwm7Regs.AQSFRC.bit.RLDCSF = 3 ;//ѡֱӼ
 //    EPwm7Regs.DBCTL.bit.OUT_MODE=0;
@@ -67,6 +68,13 @@ void PWMoff(void)
 //PWM
 void PWMopen(void)
 {
+    if(Switchrearm)//ͣһοŸλӲ֮ǰһֱ
+    {
+        Switchrearm=0;
+        ProtectReset();
+    }
+    if(FlagRegs.flagsystem.bit.faultoccur)//δλ
+        return;
     //ػж
     //ePWM1
     EPwm1Regs.AQSFRC.bit.RLDCSF = 0;//
@@ -80,6 +88,7 @@ void PWMopen(void)
     EPwm3Regs.AQSFRC.bit.RLDCSF = 0 ;//
     EPwm3Regs.AQCSFRC.all = 0x0000 ;//޶
     EPwm3Regs.DBCTL.bit.OUT_MODE=3;
+    FlagRegs.flagsystem.bit.pwmon=1;
 //    //ePWM7
 //    EPwm7Regs.AQSFRC.bit.RLDCSF = 0 ;//
 //    EPwm7Regs.AQCSFRC.all = 0x0000 ;//޶
@@ -92,6 +101,8 @@ void PWMopen(void)
 void SYSTEMoff(void)
 {
    PWMoff();//PWM
+   ProtectThreshold();//ֵУ
+   Switchrearm=1;//´οʱٸλӲ
    PIZero();
    VectorControl_zero();
 }
@@ -0,0 +1,79 @@
+/*
+ * Tlm_mirror.c
+ *   в񣬲ּTlm_mirror.h
+ */
+
+#include "DSP28x_Project.h"
+
+#define TLM ((volatile Uint16 *)TLM_BASE)
+
+#pragma CODE_SECTION(TlmCapture,"fastcode");
+#pragma DATA_SECTION(Tlm_snap,"fastdata");
+
+TLM_MIRROR_STAT Tlm_mirror=TLM_MIRROR_STAT_DEFAULTS;
+TLM_SNAP Tlm_snap=TLM_SNAP_DEFAULTS;
+
+//жץһ֡һ֡û߾Ͷһ֡ѭڰ
+void TlmCapture(void)
+{
+    if(Tlm_snap.Ready)
+    {
+        Tlm_snap.Lost++;
+        return;
+    }
+    Tlm_snap.Stamp=Tlm_snap.Count;
+    Tlm_snap.Val[0]=Ua;
+    Tlm_snap.Val[1]=Ub;
+    Tlm_snap.Val[2]=Uc;
+    Tlm_snap.Val[3]=P;
+    Tlm_snap.Val[4]=Q;
+    Tlm_snap.Val[5]=w;
+    Tlm_snap.Val[6]=theta_fan;
+    Tlm_snap.Ready=1;
+}
+
+//ѭãλ·ĳȡȣ0ĬϣжTick>=DecimжϣСҲῨס
+void TlmDecim(Uint16 d)
+{
+    Tlm_snap.Decim=d?d:TLM_DECIM;
+}
+
+//ѭã֡ŰParametȫжϾ
+void TlmService(void)
+{
+    Uint16 i;
+
+    if(!Tlm_snap.Ready)
+        return;
+    for(i=0;i<TLM_SNAP_NUM;i++)
+        Paramet[i]=Tlm_snap.Val[i];
+    Tlm_snap.Ready=0;
+    ProfilePublish();//жϸκʱReleaseΪ
+    TlmPublish();
+}
+
+//Paramet[0..TLM_NUM-1]дҳٷTlmServiceã
+//S0M3ʼ꽻C28֮ǰд
+void TlmPublish(void)
+{
+    Uint16 seq,i;
+    volatile Uint16 *page;
+    volatile float *p;
+
+    if((RAMRegs.CSxMSEL.all&S0_ACCESS)==0)
+    {
+        Tlm_mirror.Skip++;
+        return;
+    }
+    seq=TLM[0]==TLM_MAGIC?TLM[1]+1:0;
+    page=&TLM[TLM_HDR+(seq&1)*TLM_PAGE_WORDS];
+    p=(volatile float *)&page[2];
+    for(i=0;i<TLM_NUM;i++)
+        p[i]=Paramet[i];
+    page[1]=IpcCrc16(&page[2],2*TLM_NUM);
+    page[0]=seq;
+    TLM[1]=seq;//ҳдŷ
+    if(TLM[0]!=TLM_MAGIC)
+        TLM[0]=TLM_MAGIC;
+    Tlm_mirror.Seq=seq;
+}
@@ -0,0 +1,74 @@
+/*
+ * Trig_table.c
+ *   Ҳfastdata(RAML3)ϵʱ
+ */
+
+#include "DSP28x_Project.h"
+
+#define TRIG_INDEX_SCALE (TRIG_TABLE_SIZE/6.283185307)//ת±
+
+#pragma DATA_SECTION(Sin_table,"fastdata");
+float Sin_table[TRIG_TABLE_SIZE+1];
+
+void InitTrigTable(void)
+{
+    int i;
+    for(i=0;i<=TRIG_TABLE_SIZE;i++)
+    {
+        Sin_table[i]=sin(i*(6.283185307/TRIG_TABLE_SIZE));
+    }
+}
+
+float Trig_sin(float angle)
+{
+    float x,frac;
+    int32 k;
+    Uint16 idx;
+
+    x=angle*TRIG_INDEX_SCALE;
+    k=(int32)x;
+    if(x<k)//Ƕȡ
+    {
+        k--;
+    }
+    frac=x-k;
+    idx=k&TRIG_TABLE_MASK;
+    return Sin_table[idx]+frac*(Sin_table[idx+1]-Sin_table[idx]);
+}
+
+float Trig_cos(float angle)
+{
+    float x,frac;
+    int32 k;
+    Uint16 idx;
+
+    x=angle*TRIG_INDEX_SCALE;
+    k=(int32)x;
+    if(x<k)
+    {
+        k--;
+    }
+    frac=x-k;
+    idx=(k+TRIG_TABLE_QUARTER)&TRIG_TABLE_MASK;//cos(x)=sin(x+/2)
+    return Sin_table[idx]+frac*(Sin_table[idx+1]-Sin_table[idx]);
+}
+
+//ͬһǶͬʱҪsincosʱ±ֻһ
+void Trig_sincos(float angle,float *s,float *c)
+{
+    float x,frac;
+    int32 k;
+    Uint16 idx;
+
+    x=angle*TRIG_INDEX_SCALE;
+    k=(int32)x;
+    if(x<k)
+    {
+        k--;
+    }
+    frac=x-k;
+    idx=k&TRIG_TABLE_MASK;
+    *s=Sin_table[idx]+frac*(Sin_table[idx+1]-Sin_table[idx]);
+    idx=(k+TRIG_TABLE_QUARTER)&TRIG_TABLE_MASK;
+    *c=Sin_table[idx]+frac*(Sin_table[idx+1]-Sin_table[idx]);
+}
@@ -21,12 +21,12 @@ void abc_dq0p(ABC_PARK *p)
 //	 p->Ds =_IQmpy(p->Alpha,p->Cosine) + _IQmpy(p->Beta,p->Sine);
 //	 p->Qs =_IQmpy(p->Beta,p->Cosine) - _IQmpy(p->Alpha,p->Sine);
 
-     p->Sine0 = sin(p->Angle);
-     p->Sine1 = sin(p->Angle-TWObyTHREE*PI);
-     p->Sine2 = sin(p->Angle+TWObyTHREE*PI);
-	 p->Cosine0 = cos(p->Angle);
-	 p->Cosine1 = cos(p->Angle-TWObyTHREE*PI);
-	 p->Cosine2 = cos(p->Angle+TWObyTHREE*PI);
+     p->Sine0 = SIN(p->Angle);
+     p->Sine1 = SIN(p->Angle-TWObyTHREE*PI);
+     p->Sine2 = SIN(p->Angle+TWObyTHREE*PI);
+	 p->Cosine0 = COS(p->Angle);
+	 p->Cosine1 = COS(p->Angle-TWObyTHREE*PI);
+	 p->Cosine2 = COS(p->Angle+TWObyTHREE*PI);
 
 	 p->Ds =TWObyTHREE*(p->As*p->Cosine0+p->Bs*p->Cosine1+p->Cs*p->Cosine2);
 	 p->Qs =TWObyTHREE*(p->As*p->Sine0+p->Bs*p->Sine1+p->Cs*p->Sine2);
@@ -44,12 +44,12 @@ void iabc_dq0p(ABC_PARK *p)
 //	 p->Ds =_IQmpy(p->Alpha,p->Cosine) + _IQmpy(p->Beta,p->Sine);
 //	 p->Qs =_IQmpy(p->Beta,p->Cosine) - _IQmpy(p->Alpha,p->Sine);
 
-     p->Sine0 = sin(p->Angle);
-     p->Sine1 = sin(p->Angle-TWObyTHREE*PI);
-     p->Sine2 = sin(p->Angle+TWObyTHREE*PI);
-	 p->Cosine0 = cos(p->Angle);
-	 p->Cosine1 = cos(p->Angle-TWObyTHREE*PI);
-	 p->Cosine2 = cos(p->Angle+TWObyTHREE*PI);
+     p->Sine0 = SIN(p->Angle);
+     p->Sine1 = SIN(p->Angle-TWObyTHREE*PI);
+     p->Sine2 = SIN(p->Angle+TWObyTHREE*PI);
+	 p->Cosine0 = COS(p->Angle);
+	 p->Cosine1 = COS(p->Angle-TWObyTHREE*PI);
+	 p->Cosine2 = COS(p->Angle+TWObyTHREE*PI);
 
 	 p->As =p->Ds*p->Cosine0+p->Qs*p->Sine0+p->V0;
 	 p->Bs =p->Ds*p->Cosine1+p->Qs*p->Sine1+p->V0;
@@ -67,12 +67,12 @@ void abc_dq0n(ABC_PARK *p)
 //	 p->Ds =_IQmpy(p->Alpha,p->Cosine) + _IQmpy(p->Beta,p->Sine);
 //	 p->Qs =_IQmpy(p->Beta,p->Cosine) - _IQmpy(p->Alpha,p->Sine);
 
-     p->Sine0 = sin(p->Angle);
-     p->Sine1 = sin(p->Angle-TWObyTHREE*PI);
-     p->Sine2 = sin(p->Angle+TWObyTHREE*PI);
-	 p->Cosine0 = cos(p->Angle);
-	 p->Cosine1 = cos(p->Angle-TWObyTHREE*PI);
-	 p->Cosine2 = cos(p->Angle+TWObyTHREE*PI);
+     p->Sine0 = SIN(p->Angle);
+     p->Sine1 = SIN(p->Angle-TWObyTHREE*PI);
+     p->Sine2 = SIN(p->Angle+TWObyTHREE*PI);
+	 p->Cosine0 = COS(p->Angle);
+	 p->Cosine1 = COS(p->Angle-TWObyTHREE*PI);
+	 p->Cosine2 = COS(p->Angle+TWObyTHREE*PI);
 
 	 p->Ds =TWObyTHREE*(p->As*p->Cosine0+p->Bs*p->Cosine1+p->Cs*p->Cosine2);
 	 p->Qs =-TWObyTHREE*(p->As*p->Sine0+p->Bs*p->Sine1+p->Cs*p->Sine2);
@@ -90,18 +90,188 @@ void iabc_dq0n(ABC_PARK *p)
 //	 p->Ds =_IQmpy(p->Alpha,p->Cosine) + _IQmpy(p->Beta,p->Sine);
 //	 p->Qs =_IQmpy(p->Beta,p->Cosine) - _IQmpy(p->Alpha,p->Sine);
 
-     p->Sine0 = sin(p->Angle);
-     p->Sine1 = sin(p->Angle-TWObyTHREE*PI);
-     p->Sine2 = sin(p->Angle+TWObyTHREE*PI);
-	 p->Cosine0 = cos(p->Angle);
-	 p->Cosine1 = cos(p->Angle-TWObyTHREE*PI);
-	 p->Cosine2 = cos(p->Angle+TWObyTHREE*PI);
+     p->Sine0 = SIN(p->Angle);
+     p->Sine1 = SIN(p->Angle-TWObyTHREE*PI);
+     p->Sine2 = SIN(p->Angle+TWObyTHREE*PI);
+	 p->Cosine0 = COS(p->Angle);
+	 p->Cosine1 = COS(p->Angle-TWObyTHREE*PI);
+	 p->Cosine2 = COS(p->Angle+TWObyTHREE*PI);
 
 	 p->As =p->Ds*p->Cosine0-p->Qs*p->Sine0+p->V0;
 	 p->Bs =p->Ds*p->Cosine1-p->Qs*p->Sine1+p->V0;
 	 p->Cs =p->Ds*p->Cosine2-p->Qs*p->Sine2+p->V0;
 
 }
+
+//------------------------------------------------Ƕ
+//ֻһsin()/cos()ɺͽǹʽõ
+void ANGLE_CONTEXT_CALC(ANGLE_CONTEXT *p)
+{
+     SINCOS(p->Angle,&p->Sine0,&p->Cosine0);
+	 ANGLE_CONTEXT_EXPAND(p);
+}
+
+//sin()/cos()(NCO)ʱֻչ1202
+void ANGLE_CONTEXT_EXPAND(ANGLE_CONTEXT *p)
+{
+	 //-120㡢+120㣺cos120=-1/2sin120=sqrt(3)/2
+	 p->Sine1 = -0.5*p->Sine0-SQRT3byTWO*p->Cosine0;
+	 p->Sine2 = -0.5*p->Sine0+SQRT3byTWO*p->Cosine0;
+	 p->Cosine1 = -0.5*p->Cosine0+SQRT3byTWO*p->Sine0;
+	 p->Cosine2 = -0.5*p->Cosine0-SQRT3byTWO*p->Sine0;
+
+	 //2ȣ
+	 p->Sine2x = 2*p->Sine0*p->Cosine0;
+	 p->Cosine2x = p->Cosine0*p->Cosine0-p->Sine0*p->Sine0;
+}
+
+//------------------------------------------------NCO
+void NCO_CALC(NCO *p)
+{
+	 float d,cd,sd,s,c,g;
+
+	 p->Step =(Uint32)(int32)(p->W*T*NCO_PU_PER_RAD);//תзţ´ʹWΪʱҲж
+	 p->Phase +=p->Step;//32λƼȡ
+	 p->Angle =p->Phase*NCO_RAD_PER_PU;
+
+	 if(++p->Count>=NCO_RESYNC_NUM)
+	 {
+		 p->Count =0;
+		 SINCOS(p->Angle,&p->Sine,&p->Cosine);
+		 return;
+	 }
+
+	 //ת(cos,sin)<0.1rad̩չ<1e-6
+	 d =(int32)p->Step*NCO_RAD_PER_PU;
+	 cd =1-0.5*d*d;
+	 sd =d*(1-ONEbyTHREE*0.5*d*d);
+	 s =p->Sine*cd+p->Cosine*sd;
+	 c =p->Cosine*cd-p->Sine*sd;
+
+	 //ֵg1/sqrt(s^2+c^2)
+	 g =1.5-0.5*(s*s+c*c);
+	 p->Sine =s*g;
+	 p->Cosine =c*g;
+}
+
+void NCOZero(NCO *p)
+{
+	 p->Phase=0;
+	 p->Step=0;
+	 p->Angle=0;
+	 p->Sine=0;
+	 p->Cosine=1;
+	 p->Count=0;
+}
+
+//------------------------------------------------ʱ
+//Out=Inת=1.5wT<0.1radתúNCOһ̩չ
+void DELAY_COMP_ANGLE_CALC(DELAY_COMP *p,ANGLE_CONTEXT *a)
+{
+	 float d,cd,sd;
+
+	 if((p->Mode&DELAY_COMP_ANGLE)==0)
+	 {
+		 p->Out=*a;
+		 return;
+	 }
+	 d =DELAY_COMP_N*CTRL_ISR_T*p->W;
+	 cd =1-0.5*d*d;
+	 sd =d*(1-ONEbyTHREE*0.5*d*d);
+	 p->Out.Angle =a->Angle+d;
+	 p->Out.Sine0 =a->Sine0*cd+a->Cosine0*sd;
+	 p->Out.Cosine0 =a->Cosine0*cd-a->Sine0*sd;
+	 ANGLE_CONTEXT_EXPAND(&p->Out);
+}
+
+//dqһƣX_lastÿĶ£лʱһ
+void DELAY_COMP_PREDICT_CALC(DELAY_COMP *p)
+{
+	 Uint16 i;
+	 float x;
+
+	 for(i=0;i<4;i++)
+	 {
+		 x =p->X[i];
+		 if(p->Mode&DELAY_COMP_PREDICT)
+			 p->X[i] =x+DELAY_COMP_N*(x-p->X_last[i]);
+		 p->X_last[i] =x;
+	 }
+}
+
+void DELAY_COMP_MODE(DELAY_COMP *p,Uint16 sel)
+{
+	 p->Mode =sel&(DELAY_COMP_ANGLE|DELAY_COMP_PREDICT);
+}
+
+void DelayCompZero(DELAY_COMP *p)
+{
+	 Uint16 i;
+
+	 p->W=0;
+	 p->Out.Angle=0;
+	 p->Out.Sine0=0;
+	 p->Out.Cosine0=1;
+	 ANGLE_CONTEXT_EXPAND(&p->Out);
+	 for(i=0;i<4;i++)
+	 {
+		 p->X[i]=0;
+		 p->X_last[i]=0;
+	 }
+}
+
+//abc to dqǶȡ()
+void abc_dq0p_ctx(ABC_PARK *p,ANGLE_CONTEXT *a)
+{
+	 p->Ds =TWObyTHREE*(p->As*a->Cosine0+p->Bs*a->Cosine1+p->Cs*a->Cosine2);
+	 p->Qs =TWObyTHREE*(p->As*a->Sine0+p->Bs*a->Sine1+p->Cs*a->Sine2);
+	 p->V0 =ONEbyTHREE*(p->As+p->Bs+p->Cs);
+}
+//dq to abcǶȡ()
+void iabc_dq0p_ctx(ABC_PARK *p,ANGLE_CONTEXT *a)
+{
+	 p->As =p->Ds*a->Cosine0+p->Qs*a->Sine0+p->V0;
+	 p->Bs =p->Ds*a->Cosine1+p->Qs*a->Sine1+p->V0;
+	 p->Cs =p->Ds*a->Cosine2+p->Qs*a->Sine2+p->V0;
+}
+//abc to dqȼabc_dq0nAngle=-
+//sin(-)=-sin()--120㡢-+120ֱӦ+120㡢-120㣬BCཻ
+void abc_dq0n_ctx(ABC_PARK *p,ANGLE_CONTEXT *a)
+{
+	 p->Ds =TWObyTHREE*(p->As*a->Cosine0+p->Bs*a->Cosine2+p->Cs*a->Cosine1);
+	 p->Qs =TWObyTHREE*(p->As*a->Sine0+p->Bs*a->Sine2+p->Cs*a->Sine1);
+	 p->V0 =ONEbyTHREE*(p->As+p->Bs+p->Cs);
+}
+//dq to abcȼiabc_dq0nAngle=-
+void iabc_dq0n_ctx(ABC_PARK *p,ANGLE_CONTEXT *a)
+{
+	 p->As =p->Ds*a->Cosine0+p->Qs*a->Sine0+p->V0;
+	 p->Bs =p->Ds*a->Cosine2+p->Qs*a->Sine2+p->V0;
+	 p->Cs =p->Ds*a->Cosine1+p->Qs*a->Sine1+p->V0;
+}
+//ϲabc to dq
+//abc_dq0p(Angle=)abc_dq0n(Angle=-)һ£
+//Dsp=*cos+*sinQsp=*sin-*cosDsn=*cos-*sinQsn=*sin+*cos
+void abc_dq0pn(ABC_DQPN *p,ANGLE_CONTEXT *a)
+{
+	 num_t ac,as,bc,bs;
+	 num_t c=NUM_K(a->Cosine0);
+	 num_t s=NUM_K(a->Sine0);
+
+	 p->Alpha =NUM_MPY(NUM_K(TWObyTHREE),p->As)-NUM_MPY(NUM_K(ONEbyTHREE),p->Bs+p->Cs);
+	 p->Beta =NUM_MPY(NUM_K(ONEbySQRT3),p->Bs-p->Cs);
+	 p->V0 =NUM_MPY(NUM_K(ONEbyTHREE),p->As+p->Bs+p->Cs);
+
+	 ac =NUM_MPY(p->Alpha,c);
+	 as =NUM_MPY(p->Alpha,s);
+	 bc =NUM_MPY(p->Beta,c);
+	 bs =NUM_MPY(p->Beta,s);
+
+	 p->Dsp =ac+bs;
+	 p->Qsp =as-bc;
+	 p->Dsn =ac-bs;
+	 p->Qsn =as+bc;
+}
 //
 //---------------------------------pi---------------------------------------------------------------
 void PI_CONTROL_CALC( PI_CONTROL*p)
@@ -112,7 +282,7 @@ void PI_CONTROL_CALC( PI_CONTROL*p)
     //
     //U = Ki * Err
     //U =  _IQmpy(currentError ,p->qKi) ;
-    p->U = p->currentError  *p->qKi;
+    p->U = NUM_MPY(p->currentError,p->qKi);
     //p->U=_IQmpy(p->currentError ,p->qKi);
 
 	//Sum = Sum + U = Sum + Ki * Err - Kc * Exc
@@ -125,7 +295,7 @@ void PI_CONTROL_CALC( PI_CONTROL*p)
       //
     //U  = Sum + Kp * Error
     //U =   _IQmpy(currentError ,p->qKp) ;
-    p->U = p->currentError *p->qKp;
+    p->U = NUM_MPY(p->currentError,p->qKp);
     //p->U=_IQmpy( p->currentError,p->qKp);
     p->U = p->qdSum+p->U; // U = U + sum;
     //޷
@@ -136,6 +306,83 @@ void PI_CONTROL_CALC( PI_CONTROL*p)
     	p->qOut=p->qOutMin;
     else
     	p->qOut=p->U;
+    //㿹ͣExc = U - OutSum = Sum - Kc * ExcKcPI_KC_MAX
+    p->qdSum=p->qdSum-NUM_MPY((p->qKc>NUM_K(PI_KC_MAX))?NUM_K(PI_KC_MAX):p->qKc,p->U-p->qOut);
+}
+
+//------------------------------------------------PI
+//PI_CONTROL_CALCͬһѭе
+void PI_BANK_CALC(PI_BANK*b)
+{
+    Uint16 i;
+    PI_CONTROL *p;
+    num_t sum,u,out;
+
+    for(i=0;i<PI_BANK_NUM;i++)
+    {
+        p=&b->Pi[i];
+        p->currentError =p->qInRef-p->qInMeas;
+        sum=p->qdSum+NUM_MPY(p->currentError,p->qKi);
+        //޷
+        if(sum>p->qOutMax)
+            sum=p->qOutMax;
+        if(sum<p->qOutMin)
+            sum=p->qOutMin;
+        u=sum+NUM_MPY(p->currentError,p->qKp);
+        //޷
+        if(u>p->qOutMax)
+            out=p->qOutMax;
+        else if(u<p->qOutMin)
+            out=p->qOutMin;
+        else
+            out=u;
+        //㿹
+        p->qdSum=sum-NUM_MPY(p->qKc,u-out);
+        p->U=u;
+        p->qOut=out;
+    }
+}
+
+//firstʼnumд޷͵ǰֵͬʱֱӷ
+//Kc=Ki/Kpʱ䳣ȡʱ䳣PI_KC_MAX(ʱ䳣һʱ
+//Ki/Kpѳֳɱ˻ȥ)KpΪ0ʱֻ޷
+//NUM_K޷NUM_IN
+void PI_BANK_COMMIT(PI_BANK*b,Uint16 first,Uint16 num,float kp,float ki,float max,float min)
+{
+    Uint16 i;
+    PI_CONTROL *p=&b->Pi[first];
+    num_t nkp=NUM_K(kp);
+    num_t nki=NUM_K(ki);
+    float kc=(kp>0)?ki/kp:0;
+    num_t nkc=NUM_K((kc>PI_KC_MAX)?PI_KC_MAX:kc);
+    num_t nmax=NUM_IN(max);
+    num_t nmin=NUM_IN(min);
+
+    if(p->qKp==nkp&&p->qKi==nki&&p->qOutMax==nmax&&p->qOutMin==nmin)
+        return;
+
+    for(i=first;i<first+num;i++)
+    {
+        p=&b->Pi[i];
+        p->qKp=nkp;
+        p->qKi=nki;
+        p->qKc=nkc;
+        p->qOutMax=nmax;
+        p->qOutMin=nmin;
+    }
+}
+
+void PIBankZero(PI_BANK*b)
+{
+    Uint16 i;
+    for(i=0;i<PI_BANK_NUM;i++)
+    {
+        b->Pi[i].U=0;
+        b->Pi[i].qInMeas=0;
+        b->Pi[i].qInRef=0;
+        b->Pi[i].qdSum=0;
+        b->Pi[i].qOut=0;
+    }
 }
 
 //------------------------------------------------˲
@@ -161,51 +408,94 @@ void FILTRATE_CALC(FILTRATE*p)
 }
 
 //------------------------------------------------
-void JIEOU_CALC(JIEOU*p)
+void JIEOU_CALC(JIEOU*p,ANGLE_CONTEXT*a)
 {
 //	Udout=Ud-Udmean*cos(2*Angle)-Uqmean*sin(2*Angle);
 //  Uqout=Uq-Udmean*sin(2*Angle)+Uqmean*cos(2*Angle);
 
-	p->Udout=p->Ud-p->Udmean*cos(2*p->Angle)-p->Uqmean*sin(2*p->Angle);
-	p->Uqout=p->Uq-p->Udmean*sin(2*p->Angle)+p->Uqmean*cos(2*p->Angle);
+	num_t co2=NUM_K(a->Cosine2x);
+	num_t si2=NUM_K(a->Sine2x);
+
+	p->Udout=p->Ud-NUM_MPY(p->Udmean,co2)-NUM_MPY(p->Uqmean,si2);
+	p->Uqout=p->Uq-NUM_MPY(p->Udmean,si2)+NUM_MPY(p->Uqmean,co2);
+
+}
+
+//------------------------------------------------˲
+//תֱIIͣY=a1*X+S1S1=a2*X-b1*Y+S2S2=a3*X-b2*Y
+//FILTRATE_CALCֱI͵ȼۣÿ·ֻ״̬ϵȫ鹲
+void BIQUAD_BANK_CALC(BIQUAD_BANK*p)
+{
+	Uint16 i;
+	num_t x,y;
+	num_t a1=p->Coef.a1;
+	num_t a2=p->Coef.a2;
+	num_t a3=p->Coef.a3;
+	num_t b1=p->Coef.b1;
+	num_t b2=p->Coef.b2;
+
+	for(i=0;i<BIQUAD_BANK_NUM;i++)
+	{
+		x=p->X_in[i];
+		y=NUM_MPY(a1,x)+p->S1[i];
+		p->S1[i]=NUM_MPY(a2,x)-NUM_MPY(b1,y)+p->S2[i];
+		p->S2[i]=NUM_MPY(a3,x)-NUM_MPY(b2,y);
+		p->Y[i]=y;
+	}
+}
 
+#if !NUM_USE_IQ
+//ͬ12·ÿ·һFILTRATE_CALCfΪBIQUAD_BANK_NUMFILTRATEֻԱ
+void FILTRATE_BANK_CALC(BIQUAD_BANK*p,FILTRATE*f)
+{
+	Uint16 i;
+
+	for(i=0;i<BIQUAD_BANK_NUM;i++)
+	{
+		f[i].X_in=p->X_in[i];
+		FILTRATE_CALC(&f[i]);
+		p->Y[i]=f[i].Y;
+	}
 }
+#endif
 
 //------------------------------------------------DDSRF_PLL
-void DDSRF_PLL_CALC(DDSRF_PLL*p)
+//õ˲һĵ
+void DDSRF_PLL_IN(DDSRF_PLL*p,BIQUAD_BANK*f)
 {
-	p->Udpmean=p->Udp_filtrate.Y;
-	p->Uqpmean=p->Uqp_filtrate.Y;
-	p->Udnmean=p->Udn_filtrate.Y;
-	p->Uqnmean=p->Uqn_filtrate.Y;
+	num_t *x=&f->X_in[p->Ch];
+	num_t *y=&f->Y[p->Ch];
+
+	p->Udpmean=y[0];
+	p->Uqpmean=y[1];
+	p->Udnmean=y[2];
+	p->Uqnmean=y[3];
 
 	jieou_positive.Ud=p->Udp;
 	jieou_positive.Uq=p->Uqp;
 	jieou_positive.Udmean=p->Udnmean;
 	jieou_positive.Uqmean=p->Uqnmean;
-	jieou_positive.Angle=theta_fan;
-	JIEOU_CALC(&jieou_positive);
-	p->Udp_filtrate.X_in=jieou_positive.Udout;
-	FILTRATE_CALC(&p->Udp_filtrate);
-	p->Uqp_filtrate.X_in=jieou_positive.Uqout;
-	FILTRATE_CALC(&p->Uqp_filtrate);
+	JIEOU_CALC(&jieou_positive,&Theta_context);
+	x[0]=jieou_positive.Udout;
+	x[1]=jieou_positive.Uqout;
 
 	jieou_negative.Ud=p->Udn;
 	jieou_negative.Uq=p->Uqn;
 	jieou_negative.Udmean=p->Udpmean;
 	jieou_negative.Uqmean=p->Uqpmean;
-	jieou_negative.Angle=theta_fan;
-	JIEOU_CALC(&jieou_negative);
-	p->Udn_filtrate.X_in=jieou_negative.Udout;
-	FILTRATE_CALC(&p->Udn_filtrate);
-	p->Uqn_filtrate.X_in=jieou_negative.Uqout;
-	FILTRATE_CALC(&p->Uqn_filtrate);
+	JIEOU_CALC(&jieou_negative,&Theta_context);
+	x[2]=jieou_negative.Udout;
+	x[3]=jieou_negative.Uqout;
+}
 
-	p->Udpout=p->Udp_filtrate.Y;
-	p->Uqpout=p->Uqp_filtrate.Y;
-	p->Udnout=p->Udn_filtrate.Y;
-	p->Uqnout=p->Uqn_filtrate.Y;
+void DDSRF_PLL_OUT(DDSRF_PLL*p,BIQUAD_BANK*f)
+{
+	num_t *y=&f->Y[p->Ch];
 
+	p->Udpout=y[0];
+	p->Uqpout=y[1];
+	p->Udnout=y[2];
+	p->Uqnout=y[3];
 }
 
 
@@ -227,6 +517,8 @@ void Paramet_Init(void)//
     Paramet[ki_pcc]=0.05;
 
     Paramet[PI_I_max]=1000;
+    Paramet[modulation]=0;//ƷʽMODULATOR_MODE
+    Paramet[delay_comp]=0;//ʱDELAY_COMP_MODE
 }
 
 void Initparameter(void)//һЩ
@@ -257,57 +549,9 @@ void Initparameter(void)//
 
 void PIZero()//PI,ҪǻֵҪ㣬dq任ǸʵʱľͲ㡣
 {
-//ѹd
-PI_Ud.U=0;
-PI_Ud.qInMeas=0;
-PI_Ud.qInRef=0;
-PI_Ud.qOut=0;
-PI_Ud.qdSum=0;
-
-//ѹq
-PI_Uq.U=0;
-PI_Uq.qInMeas=0;
-PI_Uq.qInRef=0;
-PI_Uq.qdSum=0;
-PI_Uq.qOut=0;
-//d
-PI_Id.U=0;
-PI_Id.qInMeas=0;
-PI_Id.qInRef=0;
-PI_Id.qdSum=0;
-PI_Id.qOut=0;
-//q
-PI_Iq.U=0;
-PI_Iq.qInRef=0;
-PI_Iq.qInMeas=0;
-PI_Iq.qdSum=0;
-PI_Iq.qOut=0;
-//----------------------
-//ѹd
-PI_Udn.U=0;
-PI_Udn.qInMeas=0;
-PI_Udn.qInRef=0;
-PI_Udn.qOut=0;
-PI_Udn.qdSum=0;
-
-//ѹq
-PI_Uqn.U=0;
-PI_Uqn.qInMeas=0;
-PI_Uqn.qInRef=0;
-PI_Uqn.qdSum=0;
-PI_Uqn.qOut=0;
-//d
-PI_Idn.U=0;
-PI_Idn.qInMeas=0;
-PI_Idn.qInRef=0;
-PI_Idn.qdSum=0;
-PI_Idn.qOut=0;
-//q
-PI_Iqn.U=0;
-PI_Iqn.qInRef=0;
-PI_Iqn.qInMeas=0;
-PI_Iqn.qdSum=0;
-PI_Iqn.qOut=0;
+//ѹ(dq)治
+PIBankZero(&PI_voltage);
+PIBankZero(&PI_current);
 //PCC
 PI_PCC.U=0;
 PI_PCC.qInRef=0;
@@ -317,6 +561,16 @@ PI_PCC.qOut=0;
 
 }
 
+//λ仯ʱŰ޷дPI飬жﲻд
+//kiCTRL_KI_SCALE㵽ǰƵ
+void PIGainCommit(void)
+{
+    PI_BANK_COMMIT(&PI_voltage,PI_DP,2,kp_voltage_dqp,ki_voltage_dqp*CTRL_KI_SCALE,max_current,min_current);
+    PI_BANK_COMMIT(&PI_voltage,PI_DN,2,kp_voltage_dqn,ki_voltage_dqn*CTRL_KI_SCALE,max_current,min_current);
+    PI_BANK_COMMIT(&PI_current,PI_DP,2,kp_current_dqp,ki_current_dqp*CTRL_KI_SCALE_FAST,max_current,min_current);
+    PI_BANK_COMMIT(&PI_current,PI_DN,2,kp_current_dqn,ki_current_dqn*CTRL_KI_SCALE_FAST,max_current,min_current);
+}
+
 //ʼ
 void VectorControl_zero()
 {
@@ -370,6 +624,12 @@ void VectorControl_zero()
 	Uoqnout=0;
 
 	 theta_fan=0;
+	 NCOZero(&Theta_nco);
+	 Theta_context.Angle=0;
+	 Theta_context.Sine0=0;
+	 Theta_context.Cosine0=1;
+	 ANGLE_CONTEXT_EXPAND(&Theta_context);
+	 DelayCompZero(&Delay_comp);
 	VUFout=0;
 	VUFpcc=0;
 	VUFpccmean=0;
@@ -456,45 +716,57 @@ void droop()
 //	Iq=-2;
 
 	////////////////////////////
-      I_DDSRF_PLL.Udp=Idp;
-      I_DDSRF_PLL.Uqp=Iqp;
-      I_DDSRF_PLL.Udn=Idn;
-      I_DDSRF_PLL.Uqn=Iqn;
+#if !PWM_DOUBLE_UPDATE&&!ADC_PIPELINE
+      I_DDSRF_PLL.Udp=NUM_IN(Idp);
+      I_DDSRF_PLL.Uqp=NUM_IN(Iqp);
+      I_DDSRF_PLL.Udn=NUM_IN(Idn);
+      I_DDSRF_PLL.Uqn=NUM_IN(Iqn);
       I_DDSRF_PLL.Angle=theta_fan;
-      DDSRF_PLL_CALC(&I_DDSRF_PLL);
-      Idpout=I_DDSRF_PLL.Udpout;
-      Iqpout=I_DDSRF_PLL.Uqpout;
-      Idnout=I_DDSRF_PLL.Udnout;
-      Iqnout=I_DDSRF_PLL.Uqnout;
+      DDSRF_PLL_IN(&I_DDSRF_PLL,&Ddsrf_bank);
+#endif
+
+      U_DDSRF_PLL.Udp=NUM_IN(Udp);
+      U_DDSRF_PLL.Uqp=NUM_IN(Uqp);
+      U_DDSRF_PLL.Udn=NUM_IN(Udn);
+      U_DDSRF_PLL.Uqn=NUM_IN(Uqn);
+      U_DDSRF_PLL.Angle=theta_fan;
+      DDSRF_PLL_IN(&U_DDSRF_PLL,&Ddsrf_bank);
+
+      Uo_DDSRF_PLL.Udp=NUM_IN(Uodp);
+      Uo_DDSRF_PLL.Uqp=NUM_IN(Uoqp);
+      Uo_DDSRF_PLL.Udn=NUM_IN(Uodn);
+      Uo_DDSRF_PLL.Uqn=NUM_IN(Uoqn);
+      Uo_DDSRF_PLL.Angle=theta_fan;
+      DDSRF_PLL_IN(&Uo_DDSRF_PLL,&Ddsrf_bank);
+
+#if DDSRF_BIQUAD_BANK
+      BIQUAD_BANK_CALC(&Ddsrf_bank);//12·˲һ
+#else
+      FILTRATE_BANK_CALC(&Ddsrf_bank,Ddsrf_filtrate);
+#endif
+
+      DDSRF_PLL_OUT(&I_DDSRF_PLL,&Ddsrf_bank);
+      Idpout=NUM_OUT(I_DDSRF_PLL.Udpout);
+      Iqpout=NUM_OUT(I_DDSRF_PLL.Uqpout);
+      Idnout=NUM_OUT(I_DDSRF_PLL.Udnout);
+      Iqnout=NUM_OUT(I_DDSRF_PLL.Uqnout);
 
       pso_t[0]=Idnout;
       pso_t[1]=Iqnout;
       pso_t[2]=0;
       pso_t[3]=0;
 
-
-
-      U_DDSRF_PLL.Udp=Udp;
-      U_DDSRF_PLL.Uqp=Uqp;
-      U_DDSRF_PLL.Udn=Udn;
-      U_DDSRF_PLL.Uqn=Uqn;
-      U_DDSRF_PLL.Angle=theta_fan;
-      DDSRF_PLL_CALC(&U_DDSRF_PLL);
-      Udpout=U_DDSRF_PLL.Udpout;
-      Uqpout=U_DDSRF_PLL.Uqpout;
-      Udnout=U_DDSRF_PLL.Udnout;
-      Uqnout=U_DDSRF_PLL.Uqnout;
-
-      Uo_DDSRF_PLL.Udp=Uodp;
-      Uo_DDSRF_PLL.Uqp=Uoqp;
-      Uo_DDSRF_PLL.Udn=Uodn;
-      Uo_DDSRF_PLL.Uqn=Uoqn;
-      Uo_DDSRF_PLL.Angle=theta_fan;
-      DDSRF_PLL_CALC(&Uo_DDSRF_PLL);
-      Uodpout=Uo_DDSRF_PLL.Udpout;
-      Uoqpout=Uo_DDSRF_PLL.Uqpout;
-      Uodnout=Uo_DDSRF_PLL.Udnout;
-      Uoqnout=Uo_DDSRF_PLL.Uqnout;
+      DDSRF_PLL_OUT(&U_DDSRF_PLL,&Ddsrf_bank);
+      Udpout=NUM_OUT(U_DDSRF_PLL.Udpout);
+      Uqpout=NUM_OUT(U_DDSRF_PLL.Uqpout);
+      Udnout=NUM_OUT(U_DDSRF_PLL.Udnout);
+      Uqnout=NUM_OUT(U_DDSRF_PLL.Uqnout);
+
+      DDSRF_PLL_OUT(&Uo_DDSRF_PLL,&Ddsrf_bank);
+      Uodpout=NUM_OUT(Uo_DDSRF_PLL.Udpout);
+      Uoqpout=NUM_OUT(Uo_DDSRF_PLL.Uqpout);
+      Uodnout=NUM_OUT(Uo_DDSRF_PLL.Udnout);
+      Uoqnout=NUM_OUT(Uo_DDSRF_PLL.Uqnout);
 //-------------------------------------
 //----------------------------------------㲻ƽ
       if(n_count<5)
@@ -522,26 +794,77 @@ void droop()
 
  }
 
+//˫ʱķÿж϶㣬ֱȡ(˲ǰ)dq
+//Ddsrf_bank֮£˲ճֵ
+//ˮ߲ʱҲDDSRF(õȵѹ)neiwaihuanȡ˲ֵ
+void CurrentFeedback()
+{
+      I_DDSRF_PLL.Udp=NUM_IN(Idp);
+      I_DDSRF_PLL.Uqp=NUM_IN(Iqp);
+      I_DDSRF_PLL.Udn=NUM_IN(Idn);
+      I_DDSRF_PLL.Uqn=NUM_IN(Iqn);
+      I_DDSRF_PLL.Angle=theta_fan;
+      DDSRF_PLL_IN(&I_DDSRF_PLL,&Ddsrf_bank);
+      Idpfb=NUM_OUT(Ddsrf_bank.X_in[I_DDSRF_CH]);
+      Iqpfb=NUM_OUT(Ddsrf_bank.X_in[I_DDSRF_CH+1]);
+      Idnfb=NUM_OUT(Ddsrf_bank.X_in[I_DDSRF_CH+2]);
+      Iqnfb=NUM_OUT(Ddsrf_bank.X_in[I_DDSRF_CH+3]);
+}
+
 //--------------------ѹ---------------------------------------
+//£ÿ Ƕȡѹ˫£Ƕȡÿж㣬ѹֻ
 void neiwaihuan()
+{
+	ThetaUpdate();
+#if PWM_DOUBLE_UPDATE
+	if(Ctrl_slow)
+		waihuan();
+#else
+	waihuan();
+	Idpfb=Idpout;
+	Iqpfb=Iqpout;
+	Idnfb=Idnout;
+	Iqnfb=Iqnout;
+#endif
+	//ʱƣ任Ƕȳǰ
+	Delay_comp.X[0]=Idpfb;
+	Delay_comp.X[1]=Iqpfb;
+	Delay_comp.X[2]=Idnfb;
+	Delay_comp.X[3]=Iqnfb;
+	DELAY_COMP_PREDICT_CALC(&Delay_comp);
+	Idpfb=Delay_comp.X[0];
+	Iqpfb=Delay_comp.X[1];
+	Idnfb=Delay_comp.X[2];
+	Iqnfb=Delay_comp.X[3];
+	neihuan();
+}
+
+//λۼӣ̬²sin/cos
+void ThetaUpdate()
 {
 	pso_t[4]=w;
-	gain=w*T;
-	theta_fan=theta_fan+gain;
-	if(theta_fan>=twopi)       //ȡ
-		 {
-		theta_fan=theta_fan-twopi;
-		 }
+	Theta_nco.W=w;
+	NCO_CALC(&Theta_nco);//λۼӣ̬²sin/cos
+	theta_fan=Theta_nco.Angle;
+	Theta_context.Angle=theta_fan;
+	Theta_context.Sine0=Theta_nco.Sine;
+	Theta_context.Cosine0=Theta_nco.Cosine;
+	ANGLE_CONTEXT_EXPAND(&Theta_context);
+	Delay_comp.W=w;
+	DELAY_COMP_ANGLE_CALC(&Delay_comp,&Theta_context);
+}
 
+//ѹο
+void waihuan()
+{
 //´ƵõĲοѹ
-    Ua_ref=U*cos(theta_fan);
-    Ub_ref=U*cos(theta_fan-TWObyTHREE*PI);
-    Uc_ref=U*cos(theta_fan+TWObyTHREE*PI);
+    Ua_ref=U*Theta_context.Cosine0;
+    Ub_ref=U*Theta_context.Cosine1;
+    Uc_ref=U*Theta_context.Cosine2;
     Uref_conversion.As=Ua_ref;
     Uref_conversion.Bs=Ub_ref;
     Uref_conversion.Cs=Uc_ref;
-    Uref_conversion.Angle=theta_fan;
-    abc_dq0p(&Uref_conversion);
+    abc_dq0p_ctx(&Uref_conversion,&Theta_context);
 //------------------ѹ--------------------
 
     Ud_ref=Uref_conversion.Ds;
@@ -551,62 +874,13 @@ void neiwaihuan()
 //    delt_Uq=Uq_ref-Uqpout;
 
 //------------------ѹPI--------------------
-    //d
-        PI_Ud.qKp=kp_voltage_dqp;
-        PI_Ud.qKi=ki_voltage_dqp;
-        PI_Ud.qOutMax=max_current;
-        PI_Ud.qOutMin=min_current;
-
-    //q
-        PI_Uq.qKp=kp_voltage_dqp;
-        PI_Uq.qKi=ki_voltage_dqp;
-        PI_Uq.qOutMax=max_current;
-        PI_Uq.qOutMin=min_current;
+//޷PIGainCommit()ڲ仯ʱд룬ֻοͷ
    //d
-     PI_Ud.qInRef=Ud_ref;
-     PI_Ud.qInMeas=Udpout;
-     PI_CONTROL_CALC(&PI_Ud);//dƵѹUd
+     PI_voltage.Pi[PI_DP].qInRef=NUM_IN(Ud_ref);
+     PI_voltage.Pi[PI_DP].qInMeas=NUM_IN(Udpout);
    //q
-     PI_Uq.qInRef=Uq_ref;
-     PI_Uq.qInMeas=Uqpout;//
-   	 PI_CONTROL_CALC(&PI_Uq);//qƵѹUq
-
-   //Ud,UqţҲڱ汾εPIֵ
-   	 PIout_Ud=PI_Ud.qOut;
-   	 PIout_Uq=PI_Uq.qOut;
-
-//--------------------------------------
-     Id_ref=PIout_Ud;
-     Iq_ref=PIout_Uq;
-
-//     delt_Id=Id_ref-Idpout;
-//     delt_Iq=Iq_ref-Iqpout;
-
-//------------------PI--------------------
-    //d
-        PI_Id.qKp=kp_current_dqp;
-        PI_Id.qKi=ki_current_dqp;
-        PI_Id.qOutMax=max_current;
-        PI_Id.qOutMin=min_current;
-
-    //q
-        PI_Iq.qKp=kp_current_dqp;
-        PI_Iq.qKi=ki_current_dqp;
-        PI_Iq.qOutMax=max_current;
-        PI_Iq.qOutMin=min_current;
-
-    //d
-      PI_Id.qInRef=Id_ref;
-      PI_Id.qInMeas=Idpout;
-      PI_CONTROL_CALC(&PI_Id);//qƵѹUq
-    //q
-      PI_Iq.qInRef=Iq_ref;
-      PI_Iq.qInMeas=Iqpout;
-      PI_CONTROL_CALC(&PI_Iq);//dƵѹUd
-
-      PIout_Id=PI_Id.qOut;
-      PIout_Iq=PI_Iq.qOut;
-
+     PI_voltage.Pi[PI_QP].qInRef=NUM_IN(Uq_ref);
+     PI_voltage.Pi[PI_QP].qInMeas=NUM_IN(Uqpout);//
 
 //------------------ѹ--------------------
       if(n_count1<vn_comp)
@@ -614,48 +888,50 @@ void neiwaihuan()
       {
 //    	  delt_Udn=0;
 //    	  delt_Uqn=0;
-    	  PI_Udn.qInMeas=0;
-    	  PI_Udn.qInRef=0;
-    	  PI_Uqn.qInMeas=0;
-    	  PI_Uqn.qInRef=0;
+    	  PI_voltage.Pi[PI_DN].qInMeas=0;
+    	  PI_voltage.Pi[PI_DN].qInRef=0;
+    	  PI_voltage.Pi[PI_QN].qInMeas=0;
+    	  PI_voltage.Pi[PI_QN].qInRef=0;
     	  n_count1++;
       }
       else
       {
     	  Udn_ref=PSO_g[0];
     	  Uqn_ref=PSO_g[1];
-    	  PI_Udn.qInMeas=Udnout;
-    	  PI_Udn.qInRef=Udn_ref;
-    	  PI_Uqn.qInMeas=Uqnout;
-    	  PI_Uqn.qInRef=Uqn_ref;
+    	  PI_voltage.Pi[PI_DN].qInMeas=NUM_IN(Udnout);
+    	  PI_voltage.Pi[PI_DN].qInRef=NUM_IN(Udn_ref);
+    	  PI_voltage.Pi[PI_QN].qInMeas=NUM_IN(Uqnout);
+    	  PI_voltage.Pi[PI_QN].qInRef=NUM_IN(Uqn_ref);
 //    	  delt_Udn=Udn_ref-Udnout;
 //    	  delt_Uqn=Uqn_ref-Uqnout;
       }
-//------------------ѹPI--------------------
-  //d
-	  PI_Udn.qKp=kp_voltage_dqn;
-	  PI_Udn.qKi=ki_voltage_dqn;
-	  PI_Udn.qOutMax=max_current;
-	  PI_Udn.qOutMin=min_current;
-
-  //q
-	  PI_Uqn.qKp=kp_voltage_dqn;
-	  PI_Uqn.qKi=ki_voltage_dqn;
-	  PI_Uqn.qOutMax=max_current;
-	  PI_Uqn.qOutMin=min_current;
- //d
-//      PI_Udn.qInMeas=delt_Udn;
-//	  PI_Udn.qInMeas=Udnout;
-//	  PI_Udn.qInRef=Udn_ref;
-      PI_CONTROL_CALC(&PI_Udn);//dƵѹUd
- //q
-//      PI_Uqn.qInMeas=delt_Uqn;//
-//	  PI_Uqn.qInMeas=Uqnout;
-//	  PI_Uqn.qInRef=Uqn_ref;
-	  PI_CONTROL_CALC(&PI_Uqn);//qƵѹUq
-
-	   PIout_Udn=PI_Udn.qOut;
-	   PIout_Uqn=PI_Uqn.qOut;
+
+   	 PI_BANK_CALC(&PI_voltage);//dqѹһ
+
+   //Ud,UqţҲڱ汾εPIֵ
+   	 PIout_Ud=NUM_OUT(PI_voltage.Pi[PI_DP].qOut);
+   	 PIout_Uq=NUM_OUT(PI_voltage.Pi[PI_QP].qOut);
+	 PIout_Udn=NUM_OUT(PI_voltage.Pi[PI_DN].qOut);
+	 PIout_Uqn=NUM_OUT(PI_voltage.Pi[PI_QN].qOut);
+}
+
+//Ʋ()
+void neihuan()
+{
+//--------------------------------------
+     Id_ref=PIout_Ud;
+     Iq_ref=PIout_Uq;
+
+//     delt_Id=Id_ref-Idpout;
+//     delt_Iq=Iq_ref-Iqpout;
+
+    //d
+      PI_current.Pi[PI_DP].qInRef=NUM_IN(Id_ref);
+      PI_current.Pi[PI_DP].qInMeas=NUM_IN(Idpfb);
+    //q
+      PI_current.Pi[PI_QP].qInRef=NUM_IN(Iq_ref);
+      PI_current.Pi[PI_QP].qInMeas=NUM_IN(Iqpfb);
+
 //--------------------------------------
 	  Idn_ref=PIout_Udn;
 	  Iqn_ref=PIout_Uqn;
@@ -663,30 +939,19 @@ void neiwaihuan()
 //	  delt_Idn=Idn_ref-Idnout;
 //	  delt_Iqn=Iqn_ref-Iqnout;
 
-//------------------PI--------------------
-   //d
-	   PI_Idn.qKp=kp_current_dqn;
-	   PI_Idn.qKi=ki_current_dqn;
-	   PI_Idn.qOutMax=max_current;
-	   PI_Idn.qOutMin=min_current;
-
-   //q
-	   PI_Iqn.qKp=kp_current_dqn;
-	   PI_Iqn.qKi=ki_current_dqn;
-	   PI_Iqn.qOutMax=max_current;
-	   PI_Iqn.qOutMin=min_current;
-
    //d
-	   PI_Idn.qInMeas=Idnout;
-	   PI_Idn.qInRef=Idn_ref;
-	   PI_CONTROL_CALC(&PI_Idn);//qƵѹUq
+	   PI_current.Pi[PI_DN].qInMeas=NUM_IN(Idnfb);
+	   PI_current.Pi[PI_DN].qInRef=NUM_IN(Idn_ref);
    //q
-	   PI_Iqn.qInMeas=Iqnout;
-	   PI_Iqn.qInRef=Iqn_ref;
-	   PI_CONTROL_CALC(&PI_Iqn);//dƵѹUd
+	   PI_current.Pi[PI_QN].qInMeas=NUM_IN(Iqnfb);
+	   PI_current.Pi[PI_QN].qInRef=NUM_IN(Iqn_ref);
+
+	  PI_BANK_CALC(&PI_current);//dqһ
 
-	   PIout_Idn=PI_Idn.qOut;
-	   PIout_Iqn=PI_Iqn.qOut;
+      PIout_Id=NUM_OUT(PI_current.Pi[PI_DP].qOut);
+      PIout_Iq=NUM_OUT(PI_current.Pi[PI_QP].qOut);
+	   PIout_Idn=NUM_OUT(PI_current.Pi[PI_DN].qOut);
+	   PIout_Iqn=NUM_OUT(PI_current.Pi[PI_QN].qOut);
 //-----------------------------------------------------PI
 
   	//Ķǿ
@@ -762,12 +1027,10 @@ void neiwaihuan()
 //////////////////////////////////////////////////////////////////////////////ǲԲ
       Uout_conversion.Ds=PIout_Id;
       Uout_conversion.Qs=PIout_Iq;
-      Uout_conversion.Angle=theta_fan;
-	 iabc_dq0p(&Uout_conversion);//õua,ub,ucģ
+	 iabc_dq0p_ctx(&Uout_conversion,&Delay_comp.Out);//õua,ub,ucģǶȰʱǰ
      Uoutn_conversion.Ds=PIout_Idn;
      Uoutn_conversion.Qs=PIout_Iqn;
-     Uoutn_conversion.Angle=-theta_fan;
-	 iabc_dq0n(&Uoutn_conversion);//õua,ub,ucģ
+	 iabc_dq0n_ctx(&Uoutn_conversion,&Delay_comp.Out);//õua,ub,ucģ-(+)ͬЧʱ̵λ
 
  }
 
@@ -7,6 +7,10 @@
  */
 #include "F28M35x_Device.h"     // F28M35x Headerfile Include File
 #include "F28M35x_Examples.h"   // F28M35x Examples Include File
+#include "Ctrl_rate.h"
+#include "Adc_self.h"
+#include "bsp.h"//HAL_ADDR32
+#include "fault.h"
 
 
 void InitBoardGpio(void)
@@ -30,6 +34,38 @@ void InitBoardGpio(void)
 }
 
 
+#if ADC_DUAL
+//ADC1ADC2ADC_STEP_NUMSOCͨAdc_self.hԴADCTRIG5(EPWM1SOCA)
+//ߵתͲͬkͬʱͬʱ
+void ConfigureAdcDual(void)
+{
+    const Uint16 ch1[ADC_STEP_NUM]=ADC1_CH_MAP;
+    const Uint16 ch2[ADC_STEP_NUM]=ADC2_CH_MAP;
+    volatile union ADCSOCxCTL_REG *soc1=&Adc1Regs.ADCSOC0CTL;
+    volatile union ADCSOCxCTL_REG *soc2=&Adc2Regs.ADCSOC0CTL;
+    Uint16 i;
+
+    InitAdc2();
+
+    EALLOW;
+    Adc2Regs.ADCCTL2.bit.ADCNONOVERLAP = 1;
+    Adc2Regs.ADCCTL1.bit.INTPULSEPOS   = 1;
+    for(i=0;i<ADC_STEP_NUM;i++)
+    {
+        soc1[i].bit.CHSEL   = ch1[i];
+        soc1[i].bit.TRIGSEL = 9;                // ADCTRIG5 -> EPWM1SOCA
+        soc1[i].bit.ACQPS   = 6;
+        soc2[i].bit.CHSEL   = ch2[i];
+        soc2[i].bit.TRIGSEL = 9;
+        soc2[i].bit.ACQPS   = 6;
+    }
+    AnalogSysctrlRegs.TRIG5SEL.all     = 5;     // Assigning EPWM1SOCA to TRIGGER 5 of analog subsystem
+    Adc1Regs.INTSEL1N2.bit.INT1SEL     = ADC_LAST_SOC;
+    EDIS;
+}
+#endif
+
+
 void ConfigureADC(void)
 {
 
@@ -43,8 +79,20 @@ void ConfigureADC(void)
     Adc1Regs.ADCCTL1.bit.INTPULSEPOS   = 1;     // EOC trips after conversion result is latched
     Adc1Regs.INTSEL1N2.bit.INT1E       = 1;     // Enabled ADCINT1
     Adc1Regs.INTSEL1N2.bit.INT1CONT    = 0;     // Disable ADCINT1 Continuous mode
-    Adc1Regs.INTSEL1N2.bit.INT1SEL     = 1;     // setup EOC1 to trigger ADCINT1
-
+#if ADC_PIPELINE
+    Adc1Regs.INTSEL1N2.bit.INT1SEL     = ADC_PIPE_SOC;//תͽж
+    Adc1Regs.INTSEL1N2.bit.INT2E       = 1;     //ADCINT2ֻ־PIE
+    Adc1Regs.INTSEL1N2.bit.INT2CONT    = 0;
+    Adc1Regs.INTSEL1N2.bit.INT2SEL     = ADC_LAST_SOC;
+#else
+    Adc1Regs.INTSEL1N2.bit.INT1SEL     = ADC_LAST_SOC;//֡תٽж
+#endif
+
+#if ADC_DUAL
+    EDIS;
+    ConfigureAdcDual();
+    EALLOW;
+#else
     // Select ADC input channels
     Adc1Regs.ADCSOC0CTL.bit.CHSEL      = 0;     // set SOC0 channel select to ADC1A0
     Adc1Regs.ADCSOC1CTL.bit.CHSEL      = 2;     // set SOC1 channel select to ADC1A2
@@ -88,6 +136,13 @@ void ConfigureADC(void)
     Adc1Regs.ADCSOC7CTL.bit.ACQPS      = 6;
     Adc1Regs.ADCSOC8CTL.bit.ACQPS      = 6;
     Adc1Regs.ADCSOC9CTL.bit.ACQPS      = 6;
+#endif
+
+#if ADC_USE_DMA
+    //֡תŴDMADMAADCINT1־ģʽ
+    Adc1Regs.INTSEL1N2.bit.INT1SEL     = ADC_LAST_SOC;
+    Adc1Regs.INTSEL1N2.bit.INT1CONT    = 1;
+#endif
 
     EDIS;
 
@@ -97,6 +152,83 @@ void ConfigureADC(void)
 }
 
 
+#if ADC_USE_DMA
+//DMA CH1ADCINT1ÿһͻRESULT0~9ADC_FRAME_NUM֣
+//ģʽж(PIE 7.1)ĿĵַAdcFrameSwap黺л
+void ConfigureAdcDma(void)
+{
+    DMAInitialize();
+    DMACH1AddrConfig(&Adc_dma_buf[0][0],&AdcResult.ADCRESULT0);
+#if ADC_DUAL
+    //ͻADC1RESULT0~4ADC2RESULT0~4δ
+    DMACH1BurstConfig(ADC2_RESULT_BASE-1,1,1);
+    DMACH1TransferConfig(1,(int16)(HAL_ADDR32(&Adc2Result.ADCRESULT0)-HAL_ADDR32(&Adc1Result.ADCRESULT0)-(ADC2_RESULT_BASE-1)),1);
+    DMACH1WrapConfig(0xFFFF,0,0xFFFF,0);//
+    DMACH1ModeConfig(DMA_ADCINT1,PERINT_ENABLE,ONESHOT_ENABLE,CONT_ENABLE,
+                     SYNC_DISABLE,SYNC_SRC,OVRFLOW_DISABLE,SIXTEEN_BIT,
+                     CHINT_END,CHINT_ENABLE);
+#else
+    DMACH1BurstConfig(ADC_FRAME_NUM-1,1,1);
+    DMACH1TransferConfig(0,0,0);//һδһͻ
+    DMACH1WrapConfig(0xFFFF,0,0xFFFF,0);//
+    DMACH1ModeConfig(DMA_ADCINT1,PERINT_ENABLE,ONESHOT_DISABLE,CONT_ENABLE,
+                     SYNC_DISABLE,SYNC_SRC,OVRFLOW_DISABLE,SIXTEEN_BIT,
+                     CHINT_END,CHINT_ENABLE);
+#endif
+    StartDMACH1();
+}
+#endif
+
+
+//------------------------------------------Ӳ
+//ȽEPWM1~3ֱȽ/TZӹϵfault.h
+void ConfigureProtect(void)
+{
+    volatile struct EPWM_REGS *pwm[3]={&EPwm1Regs,&EPwm2Regs,&EPwm3Regs};
+    Uint16 i;
+
+    EALLOW;
+    GpioG2CtrlRegs.AIOMUX1.bit.AIO2 = 2;//CMP1AͬʱADC1A2
+    GpioG2CtrlRegs.AIOMUX1.bit.AIO4 = 2;//CMP2A
+    GpioG2CtrlRegs.AIOMUX1.bit.AIO6 = 2;//CMP3A
+
+    Comp1Regs.COMPCTL.bit.COMPDACEN = 1;
+    Comp1Regs.COMPCTL.bit.COMPSOURCE = 0;//˽ڲDAC
+    Comp1Regs.COMPCTL.bit.CMPINV = 0;//ֵ
+    Comp1Regs.COMPCTL.bit.SYNCSEL = 1;
+    Comp1Regs.COMPCTL.bit.QUALSEL = PROT_QUALSEL;
+    Comp2Regs.COMPCTL.all = Comp1Regs.COMPCTL.all;
+    Comp3Regs.COMPCTL.all = Comp1Regs.COMPCTL.all;
+    EDIS;
+    ProtectThreshold();//Уǰеƫ㣻Уͣʱᰴʵƫø
+
+    EALLOW;
+    for(i=0;i<3;i++)
+    {
+        pwm[i]->DCTRIPSEL.bit.DCAHCOMPSEL = PROT_TRIPIN_COMP1;
+        pwm[i]->DCTRIPSEL.bit.DCBHCOMPSEL = PROT_TRIPIN_COMP2;
+        pwm[i]->DCTRIPSEL.bit.DCALCOMPSEL = PROT_TRIPIN_COMP3;
+        pwm[i]->TZDCSEL.bit.DCAEVT1 = TZ_DCAH_HI;
+        pwm[i]->TZDCSEL.bit.DCBEVT1 = TZ_DCBH_HI;
+        pwm[i]->TZDCSEL.bit.DCAEVT2 = TZ_DCAL_HI;
+        pwm[i]->DCACTL.bit.EVT1SRCSEL = DC_EVT1;
+        pwm[i]->DCACTL.bit.EVT1FRCSYNCSEL = DC_EVT_ASYNC;//TBCLKͬ
+        pwm[i]->DCACTL.bit.EVT2SRCSEL = DC_EVT2;
+        pwm[i]->DCACTL.bit.EVT2FRCSYNCSEL = DC_EVT_ASYNC;
+        pwm[i]->DCBCTL.bit.EVT1SRCSEL = DC_EVT1;
+        pwm[i]->DCBCTL.bit.EVT1FRCSYNCSEL = DC_EVT_ASYNC;
+        pwm[i]->TZSEL.bit.DCAEVT1 = TZ_ENABLE;//һ
+        pwm[i]->TZSEL.bit.DCBEVT1 = TZ_ENABLE;//һ
+        pwm[i]->TZSEL.bit.DCAEVT2 = TZ_ENABLE;//
+        pwm[i]->TZCTL.bit.TZA = TZ_FORCE_LO;//¹ܶ
+        pwm[i]->TZCTL.bit.TZB = TZ_FORCE_LO;
+        pwm[i]->TZCLR.all = 0x007F;
+    }
+    EPwm1Regs.TZEINT.bit.OST = 1;//ֻEPWM1TZжϼǹԴ
+    EPwm1Regs.TZEINT.bit.CBC = 1;
+    EDIS;
+}
+
 void ConfigureEPwm(void)
 {
     //EPWM1-3 DRIVE
@@ -104,10 +236,9 @@ void ConfigureEPwm(void)
     //Note that the default/2 divider for ePWMs and EMIFs
     //EPWMCLK=SYSCLKOUT=150MHZ
     //ePWMģʱ  // TBCLK = EPWMCLK/(HSPCLKDIV*CLKDIV)
-    //PWM=15000TBCLK100us
+    //PWM=2*PrdTBCLKƵCtrl_rate.hCTRL_FS
 //    Uint16 Prd=7500;
-    //5K
-    Uint16 Prd=15000;
+    Uint16 Prd=CTRL_PWM_PRD;
     //Uint16 Prd_da=7500;
     // Initialize EPwm1/2/3/4/5/6/7
     //ó------------->>>>>>>>>>>>>
@@ -128,7 +259,11 @@ void ConfigureEPwm(void)
     //CC
     EPwm1Regs.CMPCTL.bit.SHDWAMODE=CC_SHADOW;//CMPAĴ ӳģʽ
     EPwm1Regs.CMPCTL.bit.SHDWBMODE=CC_SHADOW;//CMPBĴ ӳģʽ
+#if PWM_DOUBLE_UPDATE
+    EPwm1Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO_PRD;//CTR=0CTR=PRDװ
+#else
     EPwm1Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO;//CTR=0ʱװ
+#endif
     EPwm1Regs.CMPCTL.bit.LOADBMODE=CC_CTR_ZERO;//CTR=0ʱװ
     //AQ
     EPwm1Regs.AQCTLA.bit.CAU=AQ_SET;//ʱ׼ֵCMPAֵڵʹEPWM1AΪߵƽ
@@ -139,12 +274,16 @@ void ConfigureEPwm(void)
     //EPwm1Regs.DBCTL.bit.OUT_MODE=DB_FULL_ENABLE;//ʹؼ½ʱź
     EPwm1Regs.DBCTL.bit.IN_MODE=DBA_ALL;//ĬEPWM1AΪؼ½ʱźԴ
     EPwm1Regs.DBCTL.bit.POLSEL=DB_ACTV_HIC;//AHC\EPWM1Bת
-    EPwm1Regs.DBFED=200;//½ʱFED=200TBCLK
-    EPwm1Regs.DBRED=200;//ʱRED=200TBCLK
+    EPwm1Regs.DBFED=PWM_DEADBAND;//½ʱFED
+    EPwm1Regs.DBRED=PWM_DEADBAND;//ʱRED
 
     //¼ADC
     EPwm1Regs.ETSEL.bit.SOCAEN  = 1;         // ʹSOCAת
+#if PWM_DOUBLE_UPDATE
+    EPwm1Regs.ETSEL.bit.SOCASEL = ET_CTR_PRDZERO;//Ϊ0PRDʱתֱ¹ܡϹܵͨе
+#else
     EPwm1Regs.ETSEL.bit.SOCASEL = ET_CTR_ZERO;//Ϊ0ʱת
+#endif
     EPwm1Regs.ETPS.bit.SOCAPRD  = ET_1ST; // Generate pulse on 1st event
 
     //EPwm1Regs.CMPA.bit.CMPA  = 100;   // Set compare A value
@@ -164,7 +303,11 @@ void ConfigureEPwm(void)
     //CC
     EPwm2Regs.CMPCTL.bit.SHDWAMODE=CC_SHADOW;//CMPAĴ ӳģʽ
     EPwm2Regs.CMPCTL.bit.SHDWBMODE=CC_SHADOW;//CMPBĴ ӳģʽ
+#if PWM_DOUBLE_UPDATE
+    EPwm2Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO_PRD;//CTR=0CTR=PRDװ
+#else
     EPwm2Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO;//CTR=0ʱװ
+#endif
     EPwm2Regs.CMPCTL.bit.LOADBMODE=CC_CTR_ZERO;//CTR=0ʱװ
     //AQ
     EPwm2Regs.AQCTLA.bit.CAU=AQ_SET;//ʱ׼ֵCMPAֵڵʹEPWM1AΪߵƽ
@@ -175,8 +318,8 @@ void ConfigureEPwm(void)
     //EPwm1Regs.DBCTL.bit.OUT_MODE=DB_FULL_ENABLE;//ʹؼ½ʱź
     EPwm2Regs.DBCTL.bit.IN_MODE=DBA_ALL;//ĬEPWM1AΪؼ½ʱźԴ
     EPwm2Regs.DBCTL.bit.POLSEL=DB_ACTV_HIC;//AHC\EPWM1Bת
-    EPwm2Regs.DBFED=200;//½ʱFED=200TBCLK
-    EPwm2Regs.DBRED=200;//ʱRED=200TBCLK
+    EPwm2Regs.DBFED=PWM_DEADBAND;//½ʱFED
+    EPwm2Regs.DBRED=PWM_DEADBAND;//ʱRED
 
     //EPWM Moudle 3 
     //TB
@@ -192,7 +335,11 @@ void ConfigureEPwm(void)
     //CC
     EPwm3Regs.CMPCTL.bit.SHDWAMODE=CC_SHADOW;//CMPAĴ ӳģʽ
     EPwm3Regs.CMPCTL.bit.SHDWBMODE=CC_SHADOW;//CMPBĴ ӳģʽ
+#if PWM_DOUBLE_UPDATE
+    EPwm3Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO_PRD;//CTR=0CTR=PRDװ
+#else
     EPwm3Regs.CMPCTL.bit.LOADAMODE=CC_CTR_ZERO;//CTR=0ʱװ
+#endif
     EPwm3Regs.CMPCTL.bit.LOADBMODE=CC_CTR_ZERO;//CTR=0ʱװ
     //AQ
     EPwm3Regs.AQCTLA.bit.CAU=AQ_SET;//ʱ׼ֵCMPAֵڵʹEPWMAΪߵƽ
@@ -203,8 +350,8 @@ void ConfigureEPwm(void)
     //EPwm3Regs.DBCTL.bit.OUT_MODE=DB_FULL_ENABLE;//ʹؼ½ʱź
     EPwm3Regs.DBCTL.bit.IN_MODE=DBA_ALL;//ĬEPWMAΪؼ½ʱźԴ
     EPwm3Regs.DBCTL.bit.POLSEL=DB_ACTV_HIC;//AHC\EPWM1Bת
-    EPwm3Regs.DBFED=200;//½ʱFED=200TBCLK
-    EPwm3Regs.DBRED=200;//ʱRED=200TBCLK
+    EPwm3Regs.DBFED=PWM_DEADBAND;//½ʱFED
+    EPwm3Regs.DBRED=PWM_DEADBAND;//ʱRED
 
 
     //TBD
@@ -153,6 +153,71 @@ void FastFaultTest( )
 	Paramet[faultoccurr] = FlagRegs.flagsystem.bit.faultoccur;
 }
 
+//------------------------------------------Ӳ
+//DACֵУߣƫ+ֵӦADC룬ٻDAC룻
+//ƫû0(ϵ硢Уû)ʱе㣬ֵھ̬ƽ£һжϾͷ
+static Uint16 ProtectDac(Uint32 zero,float trip,float k)
+{
+    Uint32 code;
+
+    if(zero==0)
+        zero=PROT_ZERO_NOM;
+    code=zero+(Uint32)(trip/k);
+    code>>=2;
+    if(code>1023)
+        code=1023;
+    return code;
+}
+
+void ProtectThreshold(void)
+{
+    EALLOW;
+    Comp1Regs.DACVAL.bit.DACVAL=ProtectDac(AC_ZeroMean[1],PROT_I_TRIP,ADC_I);//Ib
+    Comp2Regs.DACVAL.bit.DACVAL=ProtectDac(AC_ZeroMean[3],PROT_U_TRIP,ADC_U);//Ua
+    Comp3Regs.DACVAL.bit.DACVAL=ProtectDac(AC_ZeroMean[4],PROT_U_TRIP,ADC_U);//Ub
+    EDIS;
+}
+
+//EPWM1 TZжãĸȽһתһԷλͣٿ
+void HardwareFaultLatch(void)
+{
+    if(EPwm1Regs.TZFLG.bit.DCAEVT1)
+        FlagRegs.flagfault.bit.ocfault=1;
+    if(EPwm1Regs.TZFLG.bit.DCBEVT1||EPwm1Regs.TZFLG.bit.DCAEVT2)
+        FlagRegs.flagfault.bit.hwovervoltage=1;
+    EALLOW;
+    EPwm1Regs.TZFRC.bit.OST=1;
+    EPwm2Regs.TZFRC.bit.OST=1;
+    EPwm3Regs.TZFRC.bit.OST=1;
+    EPwm1Regs.TZCLR.bit.INT=1;
+    EDIS;
+    FlagRegs.flagsystem.bit.faultoccur=1;
+    Switchsystem=0;//ͣҪ¿λ
+    Paramet[flagfault_run]=FlagRegs.flagfault.all;
+    Paramet[faultoccurr]=1;
+}
+
+//ͣһοʱ(PWMopen)зұȽѻ䣬TZ־ӲϣPWM
+//ȽûͱַҪͣһ
+void ProtectReset(void)
+{
+    if(EPwm1Regs.TZFLG.bit.OST==0&&EPwm1Regs.TZFLG.bit.CBC==0)
+        return;
+    if(Comp1Regs.COMPSTS.bit.COMPSTS||Comp2Regs.COMPSTS.bit.COMPSTS||Comp3Regs.COMPSTS.bit.COMPSTS)
+        return;
+    EALLOW;
+    EPwm1Regs.TZCLR.all=0x007F;//INTCBCOSTDCAEVT1/2DCBEVT1/2
+    EPwm2Regs.TZCLR.all=0x007F;
+    EPwm3Regs.TZCLR.all=0x007F;
+    EDIS;
+    FlagRegs.flagfault.bit.ocfault=0;
+    FlagRegs.flagfault.bit.hwovervoltage=0;
+    if(FlagRegs.flagfault.all==0)
+        FlagRegs.flagsystem.bit.faultoccur=0;
+    Paramet[flagfault_run]=FlagRegs.flagfault.all;
+    Paramet[faultoccurr]=FlagRegs.flagsystem.bit.faultoccur;
+}
+
 void faultzero()
 {
     //ϼ⼰λ
@@ -5,13 +5,9 @@
 #include "global_var.h"
 
 //AD
-Uint32 AC_Zero[12][8];
-Uint32 AC_ZeroMean[12];
-Uint16 AC_Zero_yu[12][8];
-Uint16 AC_Zero_yuz[12];
+Uint32 AC_ZeroMean[12];//ƫãֻжAdc_zero.Next
 
 Uint16 ADCresult[12] ;    //2
-Uint16 ADCZeroCNT0;      //6У600
 //Uint16 Rezidue[10];       //ڴŽʱ
 int32 ADCresultNEW[12]; //ڴȥƫ֮ݣѡ򲻼ֱƫã
 //int32 ADCresultAmend[10];  //5ڴĲ
@@ -24,6 +20,7 @@ Uint32 ad_count[3];
 
 //sci
 unsigned int Switchsystem;
+unsigned int Switchrearm;//ͣ1´οȸλӲ
 unsigned int RCBUF[24];//RS485 ջ ϵͳͨѶЭ24ݣ
 unsigned int ReciveRCOUNT;//RS485 ռ 0~11
 unsigned int RC_DataCount;   //ݼ
@@ -65,7 +62,6 @@ Uint16 N_stage=0;
 Uint16 N_stage2=0;
 Uint16 N_stage1=0;
 //־
-Uint32 n_coop=0;
 unsigned int nSerialNumber=0;
 
 
@@ -77,13 +73,13 @@ unsigned int nSerialNumber=0;
 
 
 Uint16 stage;
-struct FLAG_REGS FlagRegs={0,0};//־
+struct FLAG_REGS FlagRegs={{0},{0}};//־
 struct COUNTER_REGS CounterRegs;//
 
 
 
 //float speed_cankao=0;
-float T=0.0002;//5k
+float T=CTRL_ISR_T;//жڣNCOÿжۼһ
 //float sudu_max;
 //float kp_weak;
 //float ki_weak;
@@ -103,29 +99,42 @@ float min_current;
 float pso_t[10];
 int n_pso=0;
 
+//жõ״̬fastdataΣһDPҳ
+#pragma DATA_SECTION(PI_voltage,"fastdata");
+#pragma DATA_SECTION(PI_current,"fastdata");
+#pragma DATA_SECTION(I_conversion,"fastdata");
+#pragma DATA_SECTION(U_conversion,"fastdata");
+#pragma DATA_SECTION(Uo_conversion,"fastdata");
+#pragma DATA_SECTION(I_DDSRF_PLL,"fastdata");
+#pragma DATA_SECTION(U_DDSRF_PLL,"fastdata");
+#pragma DATA_SECTION(Uo_DDSRF_PLL,"fastdata");
+#pragma DATA_SECTION(Ddsrf_bank,"fastdata");
+#if !DDSRF_BIQUAD_BANK
+#pragma DATA_SECTION(Ddsrf_filtrate,"fastdata");
+#endif
+#pragma DATA_SECTION(Theta_context,"fastdata");
+#pragma DATA_SECTION(Theta_nco,"fastdata");
+#pragma DATA_SECTION(Delay_comp,"fastdata");
+#pragma DATA_SECTION(Modulator,"fastdata");
+
 //ṹ
 ADC_VOLT_CURRENT_GET Adcget=ADC_VOLT_CURRENT_GET_DEFAULTS;
 //PIӦĽṹ
 
 
-PI_CONTROL PI_Ud=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Uq=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Id=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Iq=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Udn=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Uqn=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Idn=PI_CONTROL_DEFAULTS;
-PI_CONTROL PI_Iqn=PI_CONTROL_DEFAULTS;
+PI_BANK PI_voltage=PI_BANK_DEFAULTS;//ѹ⻷
+PI_BANK PI_current=PI_BANK_DEFAULTS;//ڻ
 PI_CONTROL PI_PCC=PI_CONTROL_DEFAULTS;
 
 
-ABC_PARK I_conversion=CLARKE_PARK_DEFAULTS;   //е
-ABC_PARK U_conversion=CLARKE_PARK_DEFAULTS;   //˿ڵѹ
+ABC_DQPN I_conversion=ABC_DQPN_DEFAULTS;   //е
+ABC_DQPN U_conversion=ABC_DQPN_DEFAULTS;   //˿ڵѹ
 //ABC_PARK Io_conversion=CLARKE_PARK_DEFAULTS;   //PCC
-ABC_PARK Uo_conversion=CLARKE_PARK_DEFAULTS;   //PCCѹ
+ABC_DQPN Uo_conversion=ABC_DQPN_DEFAULTS;   //PCCѹ
 ABC_PARK Uref_conversion=CLARKE_PARK_DEFAULTS;   //ѹ
 ABC_PARK Uout_conversion=CLARKE_PARK_DEFAULTS;   //Ʋ
 ABC_PARK Uoutn_conversion=CLARKE_PARK_DEFAULTS;
+MODULATOR Modulator=MODULATOR_DEFAULTS;//
 //ABC_PARK test_conversion=CLARKE_PARK_DEFAULTS;   //
 //ABC_PARK test2_conversion=CLARKE_PARK_DEFAULTS;
 
@@ -139,9 +148,13 @@ JIEOU jieou_positive=JIEOU_DEFAULTS;
 JIEOU jieou_negative=JIEOU_DEFAULTS;
 
 //DDSRF_PLL test_DDSRF_PLL=DDSRF_PLL_DEFAULTS;//
-DDSRF_PLL I_DDSRF_PLL=DDSRF_PLL_DEFAULTS;
-DDSRF_PLL U_DDSRF_PLL=DDSRF_PLL_DEFAULTS;
-DDSRF_PLL Uo_DDSRF_PLL=DDSRF_PLL_DEFAULTS;
+DDSRF_PLL I_DDSRF_PLL=DDSRF_PLL_DEFAULTS(I_DDSRF_CH);
+DDSRF_PLL U_DDSRF_PLL=DDSRF_PLL_DEFAULTS(U_DDSRF_CH);
+DDSRF_PLL Uo_DDSRF_PLL=DDSRF_PLL_DEFAULTS(Uo_DDSRF_CH);
+BIQUAD_BANK Ddsrf_bank=BIQUAD_BANK_DEFAULTS_20Hz;
+#if !DDSRF_BIQUAD_BANK
+FILTRATE Ddsrf_filtrate[BIQUAD_BANK_NUM]=FILTRATE_BANK_DEFAULTS_20Hz;
+#endif
 
 float a_graph[graphNumber];
 float b_graph[graphNumber];
@@ -168,6 +181,11 @@ float Idpout=0;
 float Iqpout=0;
 float Idnout=0;
 float Iqnout=0;
+float Idpfb=0;
+float Iqpfb=0;
+float Idnfb=0;
+float Iqnfb=0;
+Uint16 Ctrl_slow=0;
 
 float Udpout=0;
 float Uqpout=0;
@@ -214,6 +232,9 @@ float delt_Iq;
                                                                                 //qֵָ
                                                                              //Ƕм
 float theta_fan;                                                                                 //Ƕȡ任
+ANGLE_CONTEXT Theta_context=ANGLE_CONTEXT_DEFAULTS;//ÿֻһsin/cos
+NCO Theta_nco=NCO_DEFAULTS;//w32λλۼ
+DELAY_COMP Delay_comp=DELAY_COMP_DEFAULTS;//ʱ
 
 //м
 float error;
@@ -295,26 +316,7 @@ union FLOAT_IPCF  IPC_send;
 float PSO_g[4]={0,0,0,0};
 
 //IPC
-//*****************************************************************************
-// At least 1 volatile global tIpcController instance is required when using
-// IPC API Drivers.
-//*****************************************************************************
-volatile tIpcController g_sIpcController1;
-volatile tIpcController g_sIpcController2;
-
 //*****************************************************************************
 // Global variable used in this example to track errors
 //*****************************************************************************
 volatile Uint16 ErrorFlag;
-volatile Uint16 wErrorFlag;
-volatile unsigned short ErrorCount;
-volatile unsigned short wErrorCount;
-
-//*****************************************************************************
-// Global variables used in this example to read/write data passed between
-// M3 and C28
-//*****************************************************************************
-Uint16 usMBuffer[usMBuffer_SIZE];
-Uint16 usCBuffer[usMBuffer_SIZE];
-Uint16 ipc_to_pso_flag=0;
-unsigned int IPC_get_flag=0;
@@ -212,7 +212,7 @@ void Checkdata(void)//
 				if(PackLength==19)//Ƿ19жǷΪȺ
 				{
 					int i;
-					if(SerialNumber=200&&CheckCode==0xff)
+					if(SerialNumber==200&&CheckCode==0xff)
 					{
 						for(i=0;i<4;i++)
 						{
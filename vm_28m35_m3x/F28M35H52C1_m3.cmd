@@ -55,8 +55,8 @@ MEMORY
     S5 (RWX)        : origin = 0x20012000, length = 0x2000
     S6 (RWX)        : origin = 0x20014000, length = 0x2000
     S7 (RWX)        : origin = 0x20016000, length = 0x2000
-    CTOMRAM (RX)    : origin = 0x2007F000, length = 0x0800
-    MTOCRAM (RWX)   : origin = 0x2007F800, length = 0x0800
+    CTOMRAM (RX)    : origin = 0x2007F000, length = 0x0400 /* 0x400 onward holds the IPC ring (self/ipc_ring.h) */
+    MTOCRAM (RWX)   : origin = 0x2007F800, length = 0x0400 /* 0x400 onward holds the IPC ring (self/ipc_ring.h) */
 }
 
 /* Section allocation in memory */
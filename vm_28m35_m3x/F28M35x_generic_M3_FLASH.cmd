@@ -51,8 +51,8 @@ MEMORY
     C2 (RWX)        : origin = 0x20004900, length = 0x1700
     C3 (RWX)        : origin = 0x20006000, length = 0x2000
 /* Message RAM */
-    CTOMRAM (RX)    : origin = 0x2007F000, length = 0x0800
-    MTOCRAM (RWX)   : origin = 0x2007F800, length = 0x0800
+    CTOMRAM (RX)    : origin = 0x2007F000, length = 0x0400 /* 0x400 onward holds the IPC ring (self/ipc_ring.h) */
+    MTOCRAM (RWX)   : origin = 0x2007F800, length = 0x0400 /* 0x400 onward holds the IPC ring (self/ipc_ring.h) */
 	
 	OTPSECLOCK       : origin = 0x00680800, length = 0x0004
     OTP_Reserved1    : origin = 0x00680804, length = 0x0004
@@ -28,6 +28,8 @@
 #include <string.h>
 #include "message.h"
 #include "global_var.h"
+#include "ipc_ring.h"
+#include "param_sync.h"
 
 //*****************************************************************************
 //
@@ -66,12 +68,6 @@ int
 main(void)
 {
 
-    // Define Local  Variables
-    unsigned short counter;
-    unsigned short *pusMBufferPt;
-    unsigned short *pusCBufferPt;
-    unsigned long *pulMsgRam;
-
     // Disable Protection
     HWREG(SYSCTL_MWRALLOW) =  0xA5A5A5A5;
 
@@ -97,13 +93,15 @@ main(void)
     {
     }
 
+    //S0M3uCRCԼ
+    IpcCrcInit();
+
+    //S0̶C28дв(tlm_mirror.h)M3Ժֻл
+    RAMMReqSharedMemAccess(S0_ACCESS, SX_C28MASTER);
+
     //  Disable writes to protected registers.
     HWREG(SYSCTL_MWRALLOW) = 0;
 
-    //  Register M3 interrupt handlers
-    //IntRegister(INT_CTOMPIC1, CtoMIPC1IntHandler);
-    IntRegister(INT_CTOMPIC2, CtoMIPC2IntHandler);
-
 
 #ifdef _FLASH
 // Copy time critical code and Flash setup code to RAM
@@ -117,44 +115,13 @@ main(void)
     FlashInit();
 #endif
 
-    // Initialize IPC Controllers
-    //IPCMInitialize (&g_sIpcController1, IPC_INT1, IPC_INT1);
-    IPCMInitialize (&g_sIpcController2, IPC_INT2, IPC_INT2);
-
     //  Enable processor interrupts.
     IntMasterEnable();
 
-    //  Enable the IPC interrupts.
-    //IntEnable(INT_CTOMPIC1);
-    IntEnable(INT_CTOMPIC2);
-
-    //pulMsgRam = (void *)M3_MTOC_PASSMSG;
-
-
-
-    pulMsgRam = (void *)M3_MTOC_PASSMSG;
-    pulMsgRam[2]= (unsigned long)&gusMBuffer[0];
-
-
-    // Initialize local variables
-    pulMsgRam = (void *)M3_CTOM_PASSMSG;
-
-    pusMBufferPt = (void *)M3_S0SARAM_START;
-    pusCBufferPt = (void *)(M3_S0SARAM_START + usMBuffer_SIZE);
-
-    ErrorCount = 0;
-
-    for (counter = 0; counter < usMBuffer_SIZE; counter++)
-    {
-        usMBuffer[counter] = 0;
-    }
-    for (counter = 0; counter < usMBuffer_SIZE; counter++)
-    {
-        gusMBuffer[counter] = 0;
-    }
-
+    //˼ϢMTOCRAMѳʼд˶˵
+    IpcRingInit();
 
-    // Spin here until C28 has written variable addresses to pulMsgRam
+    // Spin here until C28 has its ring endpoint ready
     while ((HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCSTS) & IPC_CTOMIPCSTS_IPC17) !=
            IPC_CTOMIPCSTS_IPC17)
     {
@@ -213,71 +180,16 @@ main(void)
     // Loop forever while the timers run.
     while(1)
     {
-        if(IPC_get_flag)
+        if(IPC_RING_RX_PENDING())//C28¼¼
         {
+            IPC_RING_RX_ACK();
             IPCdata_tran();
-            IPC_get_flag=0;
         }
         //ͨѶ봦
          Checkdata();
          SciSend();
-
-         if(IPC_send_flag==1)
-         {
-             // Data Block Writes
-             // Request Memory Access to S0 SARAM for M3
-             RAMMReqSharedMemAccess (S0_ACCESS, SX_M3MASTER);
-             while ((HWREG(RAM_CONFIG_BASE + RAM_O_MSXMSEL) & S0_ACCESS) != 0)
-             {
-             }
-             // Write a block of data from M3 to S0 shared RAM which is then written to a
-             // C28 address.
-             for (counter = 0; counter < usMBuffer_SIZE; counter++)
-             {
-                 pusMBufferPt[counter] = usMBuffer[counter];
-             }
-
-             IPCMtoCBlockWrite(&g_sIpcController2, pulMsgRam[2],
-                               (unsigned long)pusMBufferPt, usMBuffer_SIZE, IPC_LENGTH_16_BITS,
-                               ENABLE_BLOCKING);
-
-             // Give Memory Access to S0 SARAM to C28
-             RAMMReqSharedMemAccess (S0_ACCESS, SX_C28MASTER);
-
-             while ((HWREG(RAM_CONFIG_BASE + RAM_O_MSXMSEL) & S0_ACCESS) != S0_ACCESS)
-             {
-             }
-
-             // Read data back from C28.
-             IPCMtoCBlockRead(&g_sIpcController2, pulMsgRam[2],
-                              (unsigned long)pusCBufferPt, usMBuffer_SIZE, ENABLE_BLOCKING,
-                              IPC_FLAG17);
-
-             // Wait until read data is ready (by checking IPC Response Flag is cleared).
-             // Then check for correct data.
-             while (HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) & IPC_MTOCIPCFLG_IPC17)
-             {
-             }
-
-             for (counter = 0; counter <usMBuffer_SIZE; counter++)
-             {
-                 if (usMBuffer[counter] != pusCBufferPt[counter])
-                 {
-                     ErrorFlag = 1;
-                 }
-                 else
-                 {
-                     ErrorFlag = 0;
-                 }
-             }
-
-             if (ErrorFlag == 1)
-             {
-                 ErrorCount++;
-             }
-
-             IPC_send_flag=0;
-         }
+         SwitchSend();//ͣûͽȥĽ
+         ParamSyncPoll();//λĹĲC28
 
     }
 }
@@ -359,58 +271,14 @@ void UARTSend(const unsigned char *pucBuffer, unsigned long ulCount)
 //    HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCACK) |= IPC_CTOMIPCACK_IPC1;
 //}
 
-//*****************************************************************************
-// CtoM IPC INT2 Interrupt Handler -
-// Should never reach this ISR. This is an optional placeholder for
-// g_sIpcController2.
-//*****************************************************************************
-void
-CtoMIPC2IntHandler (void)
-{
-    // Should never reach here - Placeholder for Debug
-    tIpcMessage sMessage;
-
-    // Continue processing messages as long as CtoM GetBuffer2 is full
-    while (IpcGet (&g_sIpcController2, &sMessage,
-                   DISABLE_BLOCKING)!= STATUS_FAIL)
-    {
-        switch (sMessage.ulcommand)
-        {
-        case IPC_SET_BITS_PROTECTED:
-            IPCCtoMSetBits_Protected(&sMessage);       // Processes
-                                                       // IPCCtoMReqMemAccess()
-                                                       // function
-            break;
-        case IPC_CLEAR_BITS_PROTECTED:
-            IPCCtoMClearBits_Protected(&sMessage);     // Processes
-                                                       // IPCCtoMReqMemAccess()
-                                                       // function
-            break;
-        case IPC_BLOCK_WRITE:
-            IPCCtoMBlockWrite(&sMessage);
-            break;
-        case IPC_BLOCK_READ:
-            IPCCtoMBlockRead(&sMessage);
-            break;
-        default:
-            ErrorFlag = 1;
-            break;
-        }
-    }
-    IPC_get_flag=1;
-    // Acknowledge IPC INT2 Flag
-    HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCACK) |= IPC_CTOMIPCACK_IPC2;
-}
-
+//C28ļ¼
 void IPCdata_tran(void)
 {
-    int i=0;
+    IPC_REC rec;
 
-    for(i=0;i<44;i++)
+    while(IpcRingPop(&rec))
     {
-        IPC_get.bit.MEM1=gusMBuffer[2*i];
-        IPC_get.bit.MEM2=gusMBuffer[2*i+1];
-        Paramet[i]=IPC_get.all;
+        if(rec.Tag==IPC_REC_SYNC)//C28λ˲¼
+            ParamSyncFull();
     }
-
 }
@@ -9,6 +9,7 @@
 
 //sci
 unsigned int Switchsystem;
+unsigned int Switch_pending;//ͣûͽ˼价ѭط
 unsigned int RCBUF[24];//RS485 ջ ϵͳͨѶЭ24ݣ
 unsigned int ReciveRCOUNT;//RS485 ռ 0~11
 unsigned int RC_DataCount;   //ݼ
@@ -37,13 +38,9 @@ unsigned int SendDataNumber;     //
 //unsigned int Paramet[ParameterNumber];
 unsigned int PSO_datainit_flag;
 float Paramet[ParameterNumber];
-unsigned short usMBuffer[usMBuffer_SIZE];
-unsigned short gusMBuffer[usMBuffer_SIZE];
 float pso_t[10];
 int n_pso=0;
 
-unsigned int IPC_send_flag=0;
-unsigned int IPC_get_flag=0;
 union FLOAT_COM  Data_get;
 union FLOAT_COMF  FData_send;
 union FLOAT_COMF  FData_get;
@@ -53,17 +50,4 @@ union FLOAT_IPCF  IPC_get;
 
 float PSO_g[4]={0,0,0,0};
 
-//IPC
-//*****************************************************************************
-// At least 1 volatile global tIpcController instance is required when using
-// IPC API Drivers.
-//*****************************************************************************
-volatile tIpcController g_sIpcController1;
-volatile tIpcController g_sIpcController2;
-
-//*****************************************************************************
-// Global variable used to track errors
-//*****************************************************************************
-volatile unsigned short ErrorFlag;
-volatile unsigned short ErrorCount;
 
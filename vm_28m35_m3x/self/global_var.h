@@ -101,6 +101,8 @@
 #define slope_delt_t 83
 #define Slope_en_sign 84
 #define current_ref_limit 85
+#define delay_comp 86//ʱbit0 Ƕȳǰbit1 Ԥ
+#define tlm_decim 87//вճȡ(жϴ)0ĬTLM_DECIM
 #define rs_psm 102
 #define Ld_psm 103
 #define Lq_psm 104
@@ -112,6 +114,7 @@
 
 
 extern unsigned int Switchsystem;
+extern unsigned int Switch_pending;
 extern unsigned int RCBUF[24];//RS485 ջ ϵͳͨѶЭ25ݣ
 extern unsigned int ReciveRCOUNT;//RS485 ռ 0~25
 extern unsigned int RC_DataCount;   //ݼ
@@ -145,8 +148,6 @@ extern float pso_t[10];
 extern int n_pso;
 
 
-extern unsigned int IPC_send_flag;
-extern unsigned int IPC_get_flag;
 extern union FLOAT_COM  Data_get;
 extern union FLOAT_COMF  FData_send;
 extern union FLOAT_COMF  FData_get;
@@ -162,30 +163,10 @@ extern float PSO_g[4];
 //*****************************************************************************
 // Address Definitions
 //*****************************************************************************
-#define M3_CTOM_PASSMSG   0x2007F7E8            // CTOM MSG RAM offsets for
-                                                // passing addresses
-#define M3_MTOC_PASSMSG 0x2007FFE8  // MTOC MSG RAM offsets for passing
-                                    // addresses
 #define M3_S0SARAM_START  0x20008000            // Start of S0 SARAM in M3
                                                 // memory map
 #define M3_S1SARAM_START  0x2000A000            // Start of S1 SARAM in M3
                                                 // memory map
-#define usMBuffer_SIZE 100 //IPCͨѶ
-
-extern unsigned short usMBuffer[usMBuffer_SIZE];
-extern unsigned short gusMBuffer[usMBuffer_SIZE];
-//*****************************************************************************
-// At least 1 volatile global tIpcController instance is required when using
-// IPC API Drivers.
-//*****************************************************************************
-extern volatile tIpcController g_sIpcController1;
-extern volatile tIpcController g_sIpcController2;
-
-//*****************************************************************************
-// Global variable used to track errors
-//*****************************************************************************
-extern volatile unsigned short ErrorFlag;
-extern volatile unsigned short ErrorCount;
 
 
 #endif
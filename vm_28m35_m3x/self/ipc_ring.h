@@ -0,0 +1,58 @@
+#ifndef __IPC_RING_H__
+#define __IPC_RING_H__
+
+//˼ϢCTOMRAMMTOCRAMһߵ߻
+//ÿֻдԼͷǿϢRAMȨȶԷ
+//֡¼ʽC28pmsm_inc/Ipc_ring.hͬһģ
+//ƫƶ16λ㣬M3ַҪ2
+#define IPC_RING_OFS    0x200
+#define IPC_RING_MAGIC  0x5AA5
+#define IPC_RING_NUM    64//¼2
+#define IPC_REC_WORDS   6//Tag Arg D0 D1 Seq Crc
+#define IPC_RING_HDR    4
+
+#define IPC_RING_TX_BASE (0x2007F800+2*IPC_RING_OFS)//MTOCRAMM3д
+#define IPC_RING_RX_BASE (0x2007F000+2*IPC_RING_OFS)//CTOMRAMM3ֻ
+
+//CRC16ʽ0x1021ֵ0䣬ڴֽ˳
+//IPC_CRC_HWΪ1ʱϵԼ죺uCRC(UCRC_CONFIG_CRC16_2)C RAMS0һ̶
+//Ͳ(C28ͬ)һ²uCRCԶ˻زIpc_ring.CrcHw
+#define IPC_CRC_HW      1
+#define IPC_CRC_TEST_BASE 0x20008000//S0ʼC28֮ǰԼ
+#define IPC_CRC_REC     5//¼CRC
+
+//壺һһIPC5Էѭ鵽Ӧٰѻ
+#define IPC_RING_DOORBELL()   {HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCSET) = IPC_MTOCIPCSET_IPC5;}
+#define IPC_RING_RX_PENDING() (HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCSTS) & IPC_CTOMIPCSTS_IPC5)
+#define IPC_RING_RX_ACK()     {HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCACK) = IPC_CTOMIPCACK_IPC5;}
+
+//¼
+#define IPC_REC_PARAM  1//Arg=Paramet±꣬D0/D1=/16λSeq=ͬţM3C28
+#define IPC_REC_SWITCH 2//Arg=SwitchsystemM3C28
+#define IPC_REC_SYNC   3//C28ҪM3Ѳȫطһ飬C28M3
+
+typedef struct{unsigned short Tag;
+               unsigned short Arg;
+               unsigned short D0;
+               unsigned short D1;
+               unsigned short Seq;
+              }IPC_REC;
+
+typedef struct{unsigned short Push;//ѷ¼
+               unsigned short Drop;//Էûûȥļ¼
+               unsigned short Pop;//ռ¼
+               unsigned short Bad;//Էųһ(Էλ)¶Ĵ
+               unsigned short Crc;//CRCԶļ¼
+               unsigned short CrcHw;//1ԼͨCRCuCRC㣻0
+              }IPC_RING_STAT;
+#define IPC_RING_STAT_DEFAULTS {0,0,0,0,0,0}
+
+extern IPC_RING_STAT Ipc_ring;
+extern void IpcCrcInit(void);
+extern void IpcRingInit(void);
+extern unsigned short IpcRingFree(void);
+extern unsigned short IpcRingPush(unsigned short tag,unsigned short arg,unsigned short d0,unsigned short d1,unsigned short seq);
+extern unsigned short IpcRingPop(IPC_REC *r);
+extern unsigned short IpcCrc16(const volatile unsigned short *p,unsigned short words);
+
+#endif
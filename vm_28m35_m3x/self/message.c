@@ -9,7 +9,11 @@
 #include "global_var.h"
 #include "hw_memmap.h"
 #include "hw_types.h"
+#include "hw_ipc.h"
 #include "uart.h"
+#include "ipc_ring.h"
+#include "tlm_mirror.h"
+#include "param_sync.h"
 
 
 
@@ -137,7 +141,8 @@ void TXdeal(void)
 //        TXBUF[8]=Data_send.bit.MEM1;
 //        TXBUF[9]=Data_send.bit.MEM2;
 
-			FData_send.all=Paramet[SerialNumber];
+			if(!TlmGet(SerialNumber,&FData_send.all))//ֱӶC28S0ûñֵ
+				FData_send.all=Paramet[SerialNumber];
 			TXBUF[8]=FData_send.bit.MEM1;
 			TXBUF[9]=FData_send.bit.MEM2;
 			TXBUF[10]=FData_send.bit.MEM3;
@@ -215,19 +220,9 @@ void Checkdata(void)//
 							PSO_get.bit.MEM3=RC_DataBUF[4*i+4];
 							PSO_get.bit.MEM4=RC_DataBUF[4*i+5];
 							PSO_g[i]=PSO_get.all;
-
-							IPC_send_flag=1;
 						}
 					}
 
-                    //IPC
-                    i = 0;
-                    usMBuffer[i]=PackLength;
-                    for (i=1; i< PackLength; i++)
-                    {
-                        usMBuffer[i]=RC_DataBUF[i-1];
-                    }
-
 					flagRC = 0;
 				}
 				else
@@ -253,8 +248,8 @@ void Checkdata(void)//
 								Data_get.bit.MEM1=RC_DataBUF[2];
 								Data_get.bit.MEM2=RC_DataBUF[3];
 								Switchsystem=Data_get.all;
-
-								IPC_send_flag=1;
+								Switch_pending=1;
+								SwitchSend();
 							//}
 						}
 						if(PackLength==7)//Ƿ7//Ǵӻʾ޸ҪǶӦĴӻ
@@ -264,19 +259,9 @@ void Checkdata(void)//
 							FData_get.bit.MEM3=RC_DataBUF[4];
 							FData_get.bit.MEM4=RC_DataBUF[5];
 							Paramet[SerialNumber]=FData_get.all;
-
-							IPC_send_flag=1;
+							ParamSyncMark(SerialNumber);//ѭλC28
 						}
 
-
-						//IPC
-                        int i = 0;
-						usMBuffer[i]=PackLength;
-                        for (i=1; i< PackLength; i++)
-                        {
-                            usMBuffer[i]=RC_DataBUF[i-1];
-                        }
-
                         TXdeal(); //жͷͳ
 					}
 					else //ոʽ
@@ -294,6 +279,20 @@ void Checkdata(void)//
 
 
 
+//ͣͽ˼价C28ûţѭÿȦԣֱͽȥ
+void SwitchSend(void)
+{
+    if(Switch_pending==0||IpcRingFree()==0)
+        return;
+    if(IpcRingPush(IPC_REC_SWITCH,(unsigned short)Switchsystem,0,0,0))
+    {
+        Switch_pending=0;
+        IPC_RING_DOORBELL();
+    }
+}
+
+
+
 //SCIʹ
 void SciSend(void)
 {
@@ -46,13 +46,12 @@ extern void Checkdata(void);
 extern void ClrTxbuf(void);
 extern void cltran(void);
 extern void PSOsend(float U[10]);
+extern void SwitchSend(void);
 
 //*****************************************************************************
 // Function Prototypes
 //*****************************************************************************
 void Error(void);
-void CtoMIPC1IntHandler(void);
-void CtoMIPC2IntHandler(void);
 void IPCdata_tran(void);
 //UART
 void UARTIntHandler(void);
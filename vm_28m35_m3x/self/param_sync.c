@@ -0,0 +1,66 @@
+/*
+ *     param_sync.c
+ *
+ *     ͬͶˣ˵param_sync.h
+ *
+ */
+
+#include "global_var.h"
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_ipc.h"
+#include "ipc_ring.h"
+#include "param_sync.h"
+
+PARAM_SYNC Param_sync;//ȫֱ㼴ֵ
+
+//λParamet[idx]ѭ
+void ParamSyncMark(unsigned short idx)
+{
+    if(idx>=ParameterNumber)
+        return;
+    Param_sync.Valid[idx>>4]|=1<<(idx&15);
+    Param_sync.Dirty[idx>>4]|=1<<(idx&15);
+}
+
+//ĹĿȫ
+void ParamSyncFull(void)
+{
+    unsigned short i;
+
+    for(i=0;i<PSYNC_WORDS;i++)
+        Param_sync.Dirty[i]|=Param_sync.Valid[i];
+    Param_sync.Tick=0;
+    Param_sync.Full++;
+}
+
+//ѭãĿȥλһȦ
+void ParamSyncPoll(void)
+{
+    unsigned short i,b,idx,sent=0,full=0;
+    union FLOAT_IPCF v;
+
+    if(++Param_sync.Tick>=PSYNC_FULL_TICK)
+        ParamSyncFull();
+    for(i=0;i<PSYNC_WORDS&&sent<PSYNC_BURST&&!full;i++)
+    {
+        for(b=0;b<16&&Param_sync.Dirty[i]!=0&&sent<PSYNC_BURST;b++)
+        {
+            if((Param_sync.Dirty[i]&(1<<b))==0)
+                continue;
+            idx=(i<<4)+b;
+            v.all=Paramet[idx];
+            if(!IpcRingPush(IPC_REC_PARAM,idx,v.bit.MEM1,v.bit.MEM2,Param_sync.Seq))
+            {
+                full=1;
+                break;
+            }
+            Param_sync.Dirty[i]&=~(1<<b);
+            Param_sync.Seq++;
+            Param_sync.Tx++;
+            sent++;
+        }
+    }
+    if(sent)
+        IPC_RING_DOORBELL();
+}
@@ -0,0 +1,24 @@
+#ifndef __PARAM_SYNC_H__
+#define __PARAM_SYNC_H__
+
+//ͬ(M3C28)λĹParametλѭֻĿ
+//(±,ֵ,)C28ڻC28ҪʱѸĹĿȫطһ飬
+//C28λ˼¼λûĹĿC28Լĳֵ
+#define PSYNC_WORDS      ((ParameterNumber+15)/16)//λͼ
+#define PSYNC_BURST      16//ѭÿȦ෢ô
+#define PSYNC_FULL_TICK  200000//ѭתôȦȫطһ
+
+typedef struct{unsigned short Seq;//һ¼
+               unsigned short Tx;//
+               unsigned short Full;//ȫط
+               unsigned long  Tick;//ϴȫطѭȦ
+               unsigned short Dirty[PSYNC_WORDS];//
+               unsigned short Valid[PSYNC_WORDS];//λĹ
+              }PARAM_SYNC;
+
+extern PARAM_SYNC Param_sync;
+extern void ParamSyncMark(unsigned short idx);
+extern void ParamSyncFull(void);
+extern void ParamSyncPoll(void);
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ *     tlm_mirror.c
+ *
+ *     в񣬲ּtlm_mirror.h
+ *
+ */
+
+#include "global_var.h"
+#include "ipc_ring.h"
+#include "tlm_mirror.h"
+
+#define TLM ((volatile unsigned short *)TLM_BASE)
+
+TLM_MIRROR_STAT Tlm_mirror=TLM_MIRROR_STAT_DEFAULTS;
+
+//S0ֱӶһвɷ1
+//û±곬ΧҳCRCԻ򼸴ζC28ĵ0*v
+unsigned short TlmGet(unsigned short idx,float *v)
+{
+    unsigned short seq,t,ok;
+    volatile unsigned short *page;
+    float f;
+
+    if(TLM[0]!=TLM_MAGIC||idx>=TLM_NUM)
+    {
+        Tlm_mirror.Miss++;
+        return 0;
+    }
+    for(t=0;t<TLM_RETRY;t++)
+    {
+        seq=TLM[1];
+        page=&TLM[TLM_HDR+(seq&1)*TLM_PAGE_WORDS];
+        f=((volatile float *)&page[2])[idx];
+        ok=IpcCrc16(&page[2],2*TLM_NUM)==page[1];
+        if(TLM[1]==seq)//ʱûٷҳû
+        {
+            if(!ok)
+            {
+                Tlm_mirror.Crc++;
+                break;
+            }
+            *v=f;
+            Tlm_mirror.Read++;
+            return 1;
+        }
+        Tlm_mirror.Retry++;
+    }
+    Tlm_mirror.Miss++;
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef __TLM_MIRROR_H__
+#define __TLM_MIRROR_H__
+
+//вS0RAM̶C28дM3ֻC28˫ҳдд귢ţ
+//C28pmsm_inc/Tlm_mirror.hͬһģ
+//ƫƶ16λ㣬M3ַҪ2
+#define TLM_BASE        M3_S0SARAM_START
+#define TLM_MAGIC       0xA55A
+#define TLM_NUM         44//Paramet[0..43]״̬
+#define TLM_HDR         4
+#define TLM_PAGE_WORDS  (2+2*TLM_NUM)
+#define TLM_RETRY       3//ĹC28ξضô
+
+typedef struct{unsigned short Read;//Ĵ
+               unsigned short Retry;//ض
+               unsigned short Miss;//ûضûɣ˱ֵĴ
+               unsigned short Crc;//ҳCRCԵĴ
+              }TLM_MIRROR_STAT;
+#define TLM_MIRROR_STAT_DEFAULTS {0,0,0,0}
+
+extern TLM_MIRROR_STAT Tlm_mirror;
+extern unsigned short TlmGet(unsigned short idx,float *v);
+
+#endif